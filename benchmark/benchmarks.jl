@@ -0,0 +1,117 @@
+# Copyright (c) 2015-2017 Michael Eastwood
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# This file defines the benchmark suite in the format expected by PkgBenchmark. It can also be run
+# as a script, in which case the results are saved as JSON:
+#
+#     julia benchmark/benchmarks.jl [output.json]
+#
+# The size of the synthetic tables can be changed with the CASACORE_BENCHMARK_ROWS and
+# CASACORE_BENCHMARK_CHANNELS environment variables.
+
+using BenchmarkTools
+using CasaCore.Tables
+using CasaCore.Measures
+using Unitful
+
+const Nrows = parse(Int, get(ENV, "CASACORE_BENCHMARK_ROWS", "10000"))
+const Nchan = parse(Int, get(ENV, "CASACORE_BENCHMARK_CHANNELS", "64"))
+
+const SUITE = BenchmarkGroup()
+
+# Create the synthetic tables once and delete them when Julia exits.
+const tables = Table[]
+atexit(() -> foreach(Tables.delete, tables))
+
+function synthetic_table(T)
+    table = Tables.create(tempname()*".ms")
+    push!(tables, table)
+    Tables.add_rows!(table, Nrows)
+    if T == String
+        table["SCALAR"] = fill("Hello, world!", Nrows)
+        table["ARRAY"] = fill("Hello, world!", 4, Nchan, Nrows)
+    else
+        table["SCALAR"] = rand(T, Nrows)
+        table["ARRAY"] = rand(T, 4, Nchan, Nrows)
+    end
+    table
+end
+
+function read_cells(table, column)
+    for row = 1:Tables.num_rows(table)
+        table[column, row]
+    end
+end
+
+function write_cells(table, column, value)
+    for row = 1:Tables.num_rows(table)
+        table[column, row] = value
+    end
+end
+
+SUITE["columns"] = BenchmarkGroup()
+SUITE["cells"] = BenchmarkGroup()
+for T in (Bool, Int32, Float32, Float64, Complex64, String)
+    table = synthetic_table(T)
+    scalar = table["SCALAR"]
+    array = table["ARRAY"]
+    cell = array[:, :, 1]
+    name = string(T)
+    SUITE["columns"]["read scalar $name"] = @benchmarkable $table["SCALAR"]
+    SUITE["columns"]["write scalar $name"] = @benchmarkable $table["SCALAR"] = $scalar
+    SUITE["columns"]["read array $name"] = @benchmarkable $table["ARRAY"]
+    SUITE["columns"]["write array $name"] = @benchmarkable $table["ARRAY"] = $array
+    SUITE["cells"]["read scalar $name"] = @benchmarkable read_cells($table, "SCALAR")
+    SUITE["cells"]["write scalar $name"] = @benchmarkable write_cells($table, "SCALAR", $(scalar[1]))
+    SUITE["cells"]["read array $name"] = @benchmarkable read_cells($table, "ARRAY")
+    SUITE["cells"]["write array $name"] = @benchmarkable write_cells($table, "ARRAY", $cell)
+end
+
+SUITE["keywords"] = BenchmarkGroup()
+let table = synthetic_table(Float64)
+    table[kw"DOUBLE"] = 1.0
+    table[kw"STRING"] = "Hello, world!"
+    table["ARRAY", kw"UNIT"] = "Jy"
+    SUITE["keywords"]["read double"] = @benchmarkable $table[kw"DOUBLE"]
+    SUITE["keywords"]["write double"] = @benchmarkable $table[kw"DOUBLE"] = 2.0
+    SUITE["keywords"]["read string"] = @benchmarkable $table[kw"STRING"]
+    SUITE["keywords"]["write string"] = @benchmarkable $table[kw"STRING"] = "Goodbye!"
+    SUITE["keywords"]["read column keyword"] = @benchmarkable $table["ARRAY", kw"UNIT"]
+end
+
+SUITE["measures"] = BenchmarkGroup()
+let frame = ReferenceFrame()
+    time = Epoch(epoch"UTC", 57365.5u"d")
+    set!(frame, time)
+    set!(frame, observatory("VLA"))
+    direction = Direction(dir"J2000", "12h00m", "43d21m")
+    position = observatory("VLA")
+    SUITE["measures"]["epoch UTC->TAI"] = @benchmarkable measure($frame, $time, epoch"TAI")
+    SUITE["measures"]["epoch UTC->LAST"] = @benchmarkable measure($frame, $time, epoch"LAST")
+    SUITE["measures"]["direction J2000->AZEL"] =
+        @benchmarkable measure($frame, $direction, dir"AZEL")
+    SUITE["measures"]["direction J2000->GALACTIC"] =
+        @benchmarkable measure($frame, $direction, dir"GALACTIC")
+    SUITE["measures"]["position ITRF->WGS84"] =
+        @benchmarkable measure($frame, $position, pos"WGS84")
+end
+
+if !isinteractive() && abspath(PROGRAM_FILE) == abspath(@__FILE__)
+    output = length(ARGS) ≥ 1 ? ARGS[1] : "benchmark-results.json"
+    tune!(SUITE)
+    results = run(SUITE, verbose=true)
+    BenchmarkTools.save(output, results)
+    println("Results saved to $output")
+end
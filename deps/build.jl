@@ -1,7 +1,21 @@
 depsdir = dirname(@__FILE__)
 src = joinpath(depsdir,"src")
 
-# Build the CasaCore wrapper
-println("Building the CasaCore wrapper...")
-run(`make -C $src`)
+# Select the build flavour with the CASACORE_JL_BUILD environment variable (one of "release",
+# "debug", "profile", or "pgo"). See deps/src/Makefile.inc for details.
+flavour = get(ENV, "CASACORE_JL_BUILD", "release")
+if !(flavour in ("release", "debug", "profile", "pgo"))
+    error("unknown build flavour \"$flavour\"")
+end
+
+# Set CASACORE_JL_ARROW=1 to build support for Apache Arrow files (requires the Arrow C++ library).
+arrow = get(ENV, "CASACORE_JL_ARROW", "0") == "1" ? "ARROW=1" : "ARROW=0"
 
+# Build the CasaCore wrapper
+println("Building the CasaCore wrapper ($flavour)...")
+run(`make -C $src clean`)
+if flavour == "pgo"
+    run(`make -C $src pgo $arrow`)
+else
+    run(`make -C $src BUILD=$flavour $arrow`)
+end
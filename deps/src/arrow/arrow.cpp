@@ -0,0 +1,521 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/api.h>
+
+#include "../tables/util.h"
+
+// Stream the columns of a table to (and from) an Apache Arrow IPC file.
+//
+// Each chunk of rows is read from the table with a single `getColumnRange` and becomes one record
+// batch. Numeric data is handed to Arrow without copying it again (the Arrow buffers point at the
+// casacore array, which outlives the call to `WriteRecordBatch`).
+//
+// Type mapping:
+//
+// * Bool, Int, Float, Double, String -> boolean, int32, float32, float64, utf8
+// * Complex -> fixed_size_list<float32>[2]
+// * arrays -> fixed_size_list<element>[number of elements in each cell]
+//
+// The shape of each array column is stored in the field metadata (key "casacore.shape", as a
+// comma separated list in Fortran order) so that the importer can restore it.
+//
+// Errors are returned as a string (or nullptr on success) because casacore and Arrow errors must
+// not propagate into Julia as exceptions.
+
+static char const* const shape_key = "casacore.shape";
+
+struct ArrowError {
+    string message;
+};
+
+void check(arrow::Status const& status) {
+    if (!status.ok()) {
+        throw ArrowError{status.ToString()};
+    }
+}
+
+template <typename T>
+T check(arrow::Result<T> result) {
+    check(result.status());
+    return result.MoveValueUnsafe();
+}
+
+string format_shape(IPosition const& shape) {
+    ostringstream output;
+    for (size_t dim = 0; dim < shape.size(); ++dim) {
+        if (dim != 0) output << ",";
+        output << shape[dim];
+    }
+    return output.str();
+}
+
+IPosition parse_shape(string const& text) {
+    vector<ssize_t> dims;
+    istringstream input(text);
+    string dim;
+    while (getline(input, dim, ',')) {
+        size_t end = 0;
+        ssize_t value = 0;
+        try {
+            value = stol(dim, &end);
+        }
+        catch (logic_error&) {
+            // std::invalid_argument or std::out_of_range
+            end = 0;
+        }
+        if (end == 0 || end != dim.size() || value <= 0) {
+            throw ArrowError{"invalid " + string(shape_key) + " metadata: \"" + text + "\""};
+        }
+        dims.push_back(value);
+    }
+    if (dims.empty()) {
+        throw ArrowError{"empty " + string(shape_key) + " metadata"};
+    }
+    IPosition shape(dims.size());
+    for (size_t dim = 0; dim < dims.size(); ++dim) {
+        shape[dim] = dims[dim];
+    }
+    return shape;
+}
+
+shared_ptr<arrow::DataType> element_type(DataType type) {
+    switch (type) {
+        case TpBool:    return arrow::boolean();
+        case TpInt:     return arrow::int32();
+        case TpFloat:   return arrow::float32();
+        case TpDouble:  return arrow::float64();
+        case TpComplex: return arrow::fixed_size_list(arrow::float32(), 2);
+        case TpString:  return arrow::utf8();
+        default:        return nullptr;
+    }
+}
+
+struct ArrowColumn {
+    string name;
+    DataType type;
+    bool scalar;
+    IPosition shape;
+};
+
+// Exporting
+
+// Array columns must have the same shape in every exported row.
+IPosition export_shape(TableColumn const& column, uint start, uint stop) {
+    ColumnDesc const& desc = column.columnDesc();
+    if (desc.isFixedShape()) {
+        return desc.shape();
+    }
+    if (start == stop) {
+        throw ArrowError{"cannot determine the shape of column " + desc.name()};
+    }
+    IPosition shape;
+    for (uint row = start; row < stop; ++row) {
+        if (!column.isDefined(row) || (row != start && !column.shape(row).isEqual(shape))) {
+            throw ArrowError{"column " + desc.name() + " does not have a uniform shape"};
+        }
+        shape = column.shape(row);
+    }
+    return shape;
+}
+
+shared_ptr<arrow::Field> export_field(ArrowColumn const& column) {
+    auto type = element_type(column.type);
+    if (type == nullptr) {
+        throw ArrowError{"column " + column.name + " has an unsupported element type"};
+    }
+    if (column.scalar) {
+        return arrow::field(column.name, type, false);
+    }
+    auto metadata = arrow::key_value_metadata({shape_key}, {format_shape(column.shape)});
+    auto list = arrow::fixed_size_list(type, column.shape.product());
+    return arrow::field(column.name, list, false, metadata);
+}
+
+// Wrap `length` elements of contiguous storage without copying.
+template <typename T>
+shared_ptr<arrow::ArrayData> wrap(shared_ptr<arrow::DataType> type, T const* data, int64_t length) {
+    auto buffer = make_shared<arrow::Buffer>(reinterpret_cast<uint8_t const*>(data),
+                                             length*sizeof(T));
+    return arrow::ArrayData::Make(type, length, {nullptr, buffer}, 0);
+}
+
+shared_ptr<arrow::ArrayData> leaf_data(Array<Bool> const& array) {
+    arrow::BooleanBuilder builder;
+    check(builder.Reserve(array.nelements()));
+    for (auto itr = array.begin(); itr != array.end(); ++itr) {
+        builder.UnsafeAppend(*itr);
+    }
+    shared_ptr<arrow::Array> output;
+    check(builder.Finish(&output));
+    return output->data();
+}
+
+shared_ptr<arrow::ArrayData> leaf_data(Array<String> const& array) {
+    arrow::StringBuilder builder;
+    for (auto itr = array.begin(); itr != array.end(); ++itr) {
+        check(builder.Append(itr->data(), itr->size()));
+    }
+    shared_ptr<arrow::Array> output;
+    check(builder.Finish(&output));
+    return output->data();
+}
+
+shared_ptr<arrow::ArrayData> leaf_data(Array<Int> const& array) {
+    return wrap(arrow::int32(), array.data(), array.nelements());
+}
+
+shared_ptr<arrow::ArrayData> leaf_data(Array<Float> const& array) {
+    return wrap(arrow::float32(), array.data(), array.nelements());
+}
+
+shared_ptr<arrow::ArrayData> leaf_data(Array<Double> const& array) {
+    return wrap(arrow::float64(), array.data(), array.nelements());
+}
+
+shared_ptr<arrow::ArrayData> leaf_data(Array<Complex> const& array) {
+    auto pairs = wrap(arrow::float32(), reinterpret_cast<float const*>(array.data()),
+                      2*array.nelements());
+    return arrow::ArrayData::Make(arrow::fixed_size_list(arrow::float32(), 2), array.nelements(),
+                                  {nullptr}, {pairs}, 0);
+}
+
+// The arrays read from the table are kept alive in `storage` until the batch has been written.
+template <typename T>
+shared_ptr<arrow::Array> export_chunk(Table const& table, ArrowColumn const& column,
+                                      shared_ptr<arrow::Field> const& field,
+                                      uint start, uint length, vector<shared_ptr<void> >& storage) {
+    Slicer rows(IPosition(1, start), IPosition(1, length));
+    shared_ptr<Array<T> > array;
+    if (column.scalar) {
+        ScalarColumn<T> scalar(table, column.name);
+        array = make_shared<Array<T> >(scalar.getColumnRange(rows));
+    }
+    else {
+        ArrayColumn<T> cells(table, column.name);
+        array = make_shared<Array<T> >(cells.getColumnRange(rows));
+    }
+    if (!array->contiguousStorage()) {
+        array = make_shared<Array<T> >(array->copy());
+    }
+    storage.push_back(array);
+    auto data = leaf_data(*array);
+    if (!column.scalar) {
+        data = arrow::ArrayData::Make(field->type(), length, {nullptr}, {data}, 0);
+    }
+    return arrow::MakeArray(data);
+}
+
+shared_ptr<arrow::Array> export_chunk(Table const& table, ArrowColumn const& column,
+                                      shared_ptr<arrow::Field> const& field,
+                                      uint start, uint length, vector<shared_ptr<void> >& storage) {
+    switch (column.type) {
+        case TpBool:    return export_chunk<Bool>(table, column, field, start, length, storage);
+        case TpInt:     return export_chunk<Int>(table, column, field, start, length, storage);
+        case TpFloat:   return export_chunk<Float>(table, column, field, start, length, storage);
+        case TpDouble:  return export_chunk<Double>(table, column, field, start, length, storage);
+        case TpComplex: return export_chunk<Complex>(table, column, field, start, length, storage);
+        case TpString:  return export_chunk<String>(table, column, field, start, length, storage);
+        default:
+            throw ArrowError{"column " + column.name + " has an unsupported element type"};
+    }
+}
+
+void export_table(Table const& table, char const* path, char* const* names, int ncolumns,
+                  uint start, uint stop, uint chunk_rows) {
+    // every column is exported if none are selected
+    Vector<String> selected = ncolumns == 0 ? table.tableDesc().columnNames()
+                                            : *input_vector(names, ncolumns);
+    vector<ArrowColumn> columns;
+    arrow::FieldVector fields;
+    for (auto const& name : selected) {
+        TableColumn column(table, name);
+        ColumnDesc const& desc = column.columnDesc();
+        ArrowColumn export_column = {name, desc.dataType(), desc.isScalar(), IPosition()};
+        if (!export_column.scalar) {
+            export_column.shape = export_shape(column, start, stop);
+        }
+        columns.push_back(export_column);
+        fields.push_back(export_field(export_column));
+    }
+    auto schema = arrow::schema(fields);
+    auto file = check(arrow::io::FileOutputStream::Open(path));
+    try {
+        auto writer = check(arrow::ipc::MakeFileWriter(file, schema));
+        for (uint chunk = start; chunk < stop; chunk += chunk_rows) {
+            uint length = min(chunk_rows, stop - chunk);
+            vector<shared_ptr<void> > storage;
+            arrow::ArrayVector arrays;
+            for (size_t idx = 0; idx < columns.size(); ++idx) {
+                auto array = export_chunk(table, columns[idx], fields[idx], chunk, length,
+                                          storage);
+                arrays.push_back(array);
+            }
+            auto batch = arrow::RecordBatch::Make(schema, length, arrays);
+            check(writer->WriteRecordBatch(*batch));
+        }
+        check(writer->Close());
+        check(file->Close());
+    }
+    catch (...) {
+        // don't leave a truncated file behind
+        static_cast<void>(file->Close());
+        remove(path);
+        throw;
+    }
+}
+
+// Importing
+
+DataType import_type(shared_ptr<arrow::DataType> const& type) {
+    switch (type->id()) {
+        case arrow::Type::BOOL:   return TpBool;
+        case arrow::Type::INT32:  return TpInt;
+        case arrow::Type::FLOAT:  return TpFloat;
+        case arrow::Type::DOUBLE: return TpDouble;
+        case arrow::Type::STRING: return TpString;
+        case arrow::Type::FIXED_SIZE_LIST: {
+            auto list = static_pointer_cast<arrow::FixedSizeListType>(type);
+            if (list->list_size() == 2 && list->value_type()->id() == arrow::Type::FLOAT) {
+                return TpComplex;
+            }
+            return TpOther;
+        }
+        default: return TpOther;
+    }
+}
+
+ArrowColumn import_column(shared_ptr<arrow::Field> const& field) {
+    ArrowColumn column = {field->name(), import_type(field->type()), true, IPosition()};
+    auto metadata = field->metadata();
+    if (metadata != nullptr && metadata->FindKey(shape_key) >= 0) {
+        if (field->type()->id() != arrow::Type::FIXED_SIZE_LIST) {
+            throw ArrowError{"field " + column.name + " has " + shape_key
+                             + " metadata but is not a fixed size list"};
+        }
+        auto list = static_pointer_cast<arrow::FixedSizeListType>(field->type());
+        column.type = import_type(list->value_type());
+        column.scalar = false;
+        column.shape = parse_shape(metadata->value(metadata->FindKey(shape_key)));
+        if (column.shape.product() != list->list_size()) {
+            throw ArrowError{"the shape of field " + column.name + " does not match its length"};
+        }
+    }
+    else if (column.type == TpOther && field->type()->id() == arrow::Type::FIXED_SIZE_LIST) {
+        // a list written by some other tool is imported as a one dimensional array
+        auto list = static_pointer_cast<arrow::FixedSizeListType>(field->type());
+        column.type = import_type(list->value_type());
+        column.scalar = false;
+        column.shape = IPosition(1, list->list_size());
+    }
+    if (column.type == TpOther) {
+        throw ArrowError{"field " + column.name + " has an unsupported type"};
+    }
+    return column;
+}
+
+template <typename T>
+void add_import_column(TableDesc& desc, ArrowColumn const& column) {
+    if (column.scalar) {
+        desc.addColumn(ScalarColumnDesc<T>(column.name));
+    }
+    else {
+        desc.addColumn(ArrayColumnDesc<T>(column.name, column.shape, ColumnDesc::FixedShape));
+    }
+}
+
+void add_import_column(TableDesc& desc, ArrowColumn const& column) {
+    switch (column.type) {
+        case TpBool:    add_import_column<Bool>(desc, column);    break;
+        case TpInt:     add_import_column<Int>(desc, column);     break;
+        case TpFloat:   add_import_column<Float>(desc, column);   break;
+        case TpDouble:  add_import_column<Double>(desc, column);  break;
+        case TpComplex: add_import_column<Complex>(desc, column); break;
+        case TpString:  add_import_column<String>(desc, column);  break;
+        default: break;
+    }
+}
+
+// Descend through any fixed size lists to the array holding the individual elements, and find
+// the index of the first element of `array` within it.
+shared_ptr<arrow::Array> leaf(shared_ptr<arrow::Array> array, int64_t& index) {
+    index = 0;
+    while (array->type_id() == arrow::Type::FIXED_SIZE_LIST) {
+        auto list = static_pointer_cast<arrow::FixedSizeListArray>(array);
+        index = list->value_offset(index);
+        array = list->values();
+    }
+    return array;
+}
+
+// The tables have no notion of a missing value, so reject any array with a null anywhere (including
+// within the lists making up an array column).
+void check_no_nulls(shared_ptr<arrow::Array> array, string const& name) {
+    while (true) {
+        if (array->null_count() > 0) {
+            throw ArrowError{"field " + name + " contains null values"};
+        }
+        if (array->type_id() != arrow::Type::FIXED_SIZE_LIST) {
+            return;
+        }
+        array = static_pointer_cast<arrow::FixedSizeListArray>(array)->values();
+    }
+}
+
+template <typename T, typename ArrowArray>
+void fill_numeric(shared_ptr<arrow::Array> const& array, Array<T>& output) {
+    int64_t index;
+    auto values = static_pointer_cast<ArrowArray>(leaf(array, index));
+    auto raw = reinterpret_cast<T const*>(values->raw_values() + index);
+    std::copy(raw, raw + output.nelements(), output.data());
+}
+
+void fill(shared_ptr<arrow::Array> const& array, Array<Int>& output) {
+    fill_numeric<Int, arrow::Int32Array>(array, output);
+}
+
+void fill(shared_ptr<arrow::Array> const& array, Array<Float>& output) {
+    fill_numeric<Float, arrow::FloatArray>(array, output);
+}
+
+void fill(shared_ptr<arrow::Array> const& array, Array<Double>& output) {
+    fill_numeric<Double, arrow::DoubleArray>(array, output);
+}
+
+void fill(shared_ptr<arrow::Array> const& array, Array<Complex>& output) {
+    // the pairs of floats are laid out exactly like std::complex<float>
+    int64_t index;
+    auto values = static_pointer_cast<arrow::FloatArray>(leaf(array, index));
+    auto raw = reinterpret_cast<Complex const*>(values->raw_values() + index);
+    std::copy(raw, raw + output.nelements(), output.data());
+}
+
+void fill(shared_ptr<arrow::Array> const& array, Array<Bool>& output) {
+    int64_t index;
+    auto values = static_pointer_cast<arrow::BooleanArray>(leaf(array, index));
+    Bool* data = output.data();
+    for (size_t idx = 0; idx < output.nelements(); ++idx) {
+        data[idx] = values->Value(index + idx);
+    }
+}
+
+void fill(shared_ptr<arrow::Array> const& array, Array<String>& output) {
+    int64_t index;
+    auto values = static_pointer_cast<arrow::StringArray>(leaf(array, index));
+    String* data = output.data();
+    for (size_t idx = 0; idx < output.nelements(); ++idx) {
+        data[idx] = String(values->GetString(index + idx));
+    }
+}
+
+template <typename T>
+void import_chunk(Table& table, ArrowColumn const& column, shared_ptr<arrow::Array> const& array,
+                  uint start) {
+    uint length = array->length();
+    check_no_nulls(array, column.name);
+    Slicer rows(IPosition(1, start), IPosition(1, length));
+    if (column.scalar) {
+        Vector<T> output(length);
+        fill(array, output);
+        ScalarColumn<T>(table, column.name).putColumnRange(rows, output);
+    }
+    else {
+        IPosition shape = column.shape;
+        shape.append(IPosition(1, length));
+        Array<T> output(shape);
+        fill(array, output);
+        ArrayColumn<T>(table, column.name).putColumnRange(rows, output);
+    }
+}
+
+void import_chunk(Table& table, ArrowColumn const& column, shared_ptr<arrow::Array> const& array,
+                  uint start) {
+    switch (column.type) {
+        case TpBool:    import_chunk<Bool>(table, column, array, start);    break;
+        case TpInt:     import_chunk<Int>(table, column, array, start);     break;
+        case TpFloat:   import_chunk<Float>(table, column, array, start);   break;
+        case TpDouble:  import_chunk<Double>(table, column, array, start);  break;
+        case TpComplex: import_chunk<Complex>(table, column, array, start); break;
+        case TpString:  import_chunk<String>(table, column, array, start);  break;
+        default: break;
+    }
+}
+
+Table* import_table(char const* arrow_path, char const* table_path) {
+    auto file = check(arrow::io::ReadableFile::Open(arrow_path));
+    auto reader = check(arrow::ipc::RecordBatchFileReader::Open(file));
+    auto schema = reader->schema();
+    vector<ArrowColumn> columns;
+    TableDesc desc;
+    for (auto const& field : schema->fields()) {
+        columns.push_back(import_column(field));
+        add_import_column(desc, columns.back());
+    }
+    SetupNewTable maker(table_path, desc, Table::NewNoReplace);
+    unique_ptr<Table> table(new Table(maker, 0));
+    try {
+        for (int batch_idx = 0; batch_idx < reader->num_record_batches(); ++batch_idx) {
+            auto batch = check(reader->ReadRecordBatch(batch_idx));
+            uint start = table->nrow();
+            table->addRow(batch->num_rows());
+            for (size_t idx = 0; idx < columns.size(); ++idx) {
+                import_chunk(*table, columns[idx], batch->column(idx), start);
+            }
+        }
+    }
+    catch (...) {
+        // don't leave a half-written table behind (it is deleted when `table` goes out of scope)
+        table->markForDelete();
+        throw;
+    }
+    return table.release();
+}
+
+extern "C" {
+    char* arrow_export_table(Table* t, char* path, char** columns, int ncolumns,
+                             uint start, uint stop, uint chunk_rows) {
+        STATS_SCOPE();
+        try {
+            export_table(*t, path, columns, ncolumns, start, stop, chunk_rows);
+        }
+        catch (ArrowError& error) {
+            return output_string(error.message);
+        }
+        catch (AipsError& error) {
+            return output_string(error.getMesg());
+        }
+        return nullptr;
+    }
+
+    Table* arrow_import_table(char* arrow_path, char* table_path, char** error_message) {
+        STATS_SCOPE();
+        *error_message = nullptr;
+        try {
+            return import_table(arrow_path, table_path);
+        }
+        catch (ArrowError& error) {
+            *error_message = output_string(error.message);
+        }
+        catch (AipsError& error) {
+            *error_message = output_string(error.getMesg());
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,449 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "../tables/util.h"
+#include "../measures/measures.h"
+
+// This benchmark calls the same entry points that are called from Julia, so it measures the cost
+// of the wrapper (including the copies made in util.h) as well as the cost of casacore itself.
+// Each result is written as one JSON object per line so that the output can easily be collected
+// and compared between releases.
+//
+// Usage: benchmark [--rows N] [--channels N] [--repeat N] [--directory PATH] [--output FILE]
+
+extern "C" {
+    Table* new_table_create(char* path);
+    void delete_table(Table* t);
+    void add_rows(Table* t, uint number);
+
+    void add_scalar_column_boolean(Table* t, char* name);
+    void add_scalar_column_int(Table* t, char* name);
+    void add_scalar_column_float(Table* t, char* name);
+    void add_scalar_column_double(Table* t, char* name);
+    void add_scalar_column_complex(Table* t, char* name);
+    void add_scalar_column_string(Table* t, char* name);
+    void add_array_column_boolean(Table* t, char* name, int* dim, int ndim);
+    void add_array_column_int(Table* t, char* name, int* dim, int ndim);
+    void add_array_column_float(Table* t, char* name, int* dim, int ndim);
+    void add_array_column_double(Table* t, char* name, int* dim, int ndim);
+    void add_array_column_complex(Table* t, char* name, int* dim, int ndim);
+    void add_array_column_string(Table* t, char* name, int* dim, int ndim);
+
+    bool* get_column_boolean(Table* t, char* name);
+    int* get_column_int(Table* t, char* name);
+    float* get_column_float(Table* t, char* name);
+    double* get_column_double(Table* t, char* name);
+    cmplx* get_column_complex(Table* t, char* name);
+    char** get_column_string(Table* t, char* name);
+    void put_column_boolean(Table* t, char* name, bool* input, int* dims, int ndim);
+    void put_column_int(Table* t, char* name, int* input, int* dims, int ndim);
+    void put_column_float(Table* t, char* name, float* input, int* dims, int ndim);
+    void put_column_double(Table* t, char* name, double* input, int* dims, int ndim);
+    void put_column_complex(Table* t, char* name, cmplx* input, int* dims, int ndim);
+    void put_column_string(Table* t, char* name, char** input, int* dims, int ndim);
+
+    bool* get_cell_array_boolean(Table* t, char* name, uint row);
+    int* get_cell_array_int(Table* t, char* name, uint row);
+    float* get_cell_array_float(Table* t, char* name, uint row);
+    double* get_cell_array_double(Table* t, char* name, uint row);
+    cmplx* get_cell_array_complex(Table* t, char* name, uint row);
+    char** get_cell_array_string(Table* t, char* name, uint row);
+    void put_cell_array_boolean(Table* t, char* name, uint row, bool* input, int* dims, int ndim);
+    void put_cell_array_int(Table* t, char* name, uint row, int* input, int* dims, int ndim);
+    void put_cell_array_float(Table* t, char* name, uint row, float* input, int* dims, int ndim);
+    void put_cell_array_double(Table* t, char* name, uint row, double* input, int* dims, int ndim);
+    void put_cell_array_complex(Table* t, char* name, uint row, cmplx* input, int* dims, int ndim);
+    void put_cell_array_string(Table* t, char* name, uint row, char** input, int* dims, int ndim);
+
+    double get_cell_scalar_double(Table* t, char* name, uint row);
+    void put_cell_scalar_double(Table* t, char* name, uint row, double input);
+
+    double get_keyword_double(Table* t, char* keyword);
+    void put_keyword_double(Table* t, char* keyword, double input);
+    char* get_keyword_string(Table* t, char* keyword);
+    void put_keyword_string(Table* t, char* keyword, char* input);
+
+    Epoch convertEpoch(Epoch* input, int newsys);
+    Direction convertDirection(Direction* input, int newsys, ReferenceFrame* frame);
+    Position convertPosition(Position* input, int newsys, ReferenceFrame* frame);
+    bool observatory(Position* position, char* name);
+}
+
+// Results are accumulated here so that the compiler cannot optimize away the calls.
+static volatile double sink = 0;
+
+struct Config {
+    uint rows = 10000;
+    int channels = 64;
+    int repeat = 5;
+    string directory = "/tmp";
+    FILE* output = stdout;
+};
+
+struct Timing {
+    double best;
+    double mean;
+};
+
+template <typename F>
+Timing measure(Config const& config, F f) {
+    vector<double> seconds;
+    for (int idx = 0; idx < config.repeat; ++idx) {
+        auto start = chrono::steady_clock::now();
+        f();
+        auto stop = chrono::steady_clock::now();
+        seconds.push_back(chrono::duration<double>(stop - start).count());
+    }
+    Timing timing;
+    timing.best = *min_element(seconds.begin(), seconds.end());
+    timing.mean = 0;
+    for (double s : seconds) timing.mean += s;
+    timing.mean /= seconds.size();
+    return timing;
+}
+
+void report(Config const& config, char const* benchmark, char const* type, char const* shape,
+            Timing timing, double bytes, double calls) {
+    fprintf(config.output,
+            "{\"benchmark\": \"%s\", \"type\": \"%s\", \"shape\": \"%s\", \"rows\": %u, "
+            "\"repeat\": %d, \"best_seconds\": %.9g, \"mean_seconds\": %.9g, "
+            "\"bytes_per_second\": %.9g, \"calls_per_second\": %.9g}\n",
+            benchmark, type, shape, config.rows, config.repeat, timing.best, timing.mean,
+            bytes / timing.best, calls / timing.best);
+    fflush(config.output);
+}
+
+// Each element type needs its own set of entry points, so collect them here.
+
+template <typename T>
+struct Entry {
+    typedef void (*AddScalar)(Table*, char*);
+    typedef void (*AddArray)(Table*, char*, int*, int);
+    typedef T* (*GetColumn)(Table*, char*);
+    typedef void (*PutColumn)(Table*, char*, T*, int*, int);
+    typedef T* (*GetCell)(Table*, char*, uint);
+    typedef void (*PutCell)(Table*, char*, uint, T*, int*, int);
+    char const* name;
+    AddScalar add_scalar;
+    AddArray add_array;
+    GetColumn get_column;
+    PutColumn put_column;
+    GetCell get_cell;
+    PutCell put_cell;
+};
+
+template <typename T> T make_value(size_t idx) {return T(idx % 1000);}
+template <> bool make_value<bool>(size_t idx) {return idx % 2 == 0;}
+template <> cmplx make_value<cmplx>(size_t idx) {return cmplx(idx % 1000, -(idx % 1000));}
+
+template <typename T> void free_output(T* output, size_t) {delete[] output;}
+template <> void free_output<char*>(char** output, size_t length) {
+    for (size_t idx = 0; idx < length; ++idx) {
+        free_string(output[idx]);
+    }
+    delete[] output;
+}
+
+template <typename T> size_t element_bytes(T const&) {return sizeof(T);}
+template <> size_t element_bytes<char*>(char* const& value) {return strlen(value);}
+
+// The input buffers are passed as raw arrays (rather than as vectors) because `vector<bool>` is
+// packed and cannot hand out a `bool*`.
+template <typename T>
+void benchmark_type(Config const& config, Entry<T> const& entry,
+                    T* scalar_input, size_t scalar_length, T* array_input, size_t array_length) {
+    string path = config.directory + "/casacore-benchmark-" + to_string(getpid()) + "-"
+                  + entry.name + ".ms";
+    Table* t = new_table_create(const_cast<char*>(path.c_str()));
+    t->markForDelete();
+    add_rows(t, config.rows);
+
+    char scalar[] = "SCALAR";
+    char array[] = "ARRAY";
+    int cell_shape[2] = {4, config.channels};
+    int scalar_dims[1] = {int(config.rows)};
+    int array_dims[3] = {4, config.channels, int(config.rows)};
+    entry.add_scalar(t, scalar);
+    entry.add_array(t, array, cell_shape, 2);
+
+    double scalar_bytes = 0;
+    for (size_t idx = 0; idx < scalar_length; ++idx) {
+        scalar_bytes += element_bytes(scalar_input[idx]);
+    }
+    double array_bytes = 0;
+    for (size_t idx = 0; idx < array_length; ++idx) {
+        array_bytes += element_bytes(array_input[idx]);
+    }
+    double cell_bytes = array_bytes / config.rows;
+    char shape[64];
+    snprintf(shape, sizeof(shape), "4x%d", config.channels);
+
+    auto timing = measure(config, [&]() {
+        entry.put_column(t, scalar, scalar_input, scalar_dims, 1);
+    });
+    report(config, "put_column", entry.name, "scalar", timing, scalar_bytes, 1);
+
+    timing = measure(config, [&]() {
+        free_output(entry.get_column(t, scalar), scalar_length);
+    });
+    report(config, "get_column", entry.name, "scalar", timing, scalar_bytes, 1);
+
+    timing = measure(config, [&]() {
+        entry.put_column(t, array, array_input, array_dims, 3);
+    });
+    report(config, "put_column", entry.name, shape, timing, array_bytes, 1);
+
+    timing = measure(config, [&]() {
+        free_output(entry.get_column(t, array), array_length);
+    });
+    report(config, "get_column", entry.name, shape, timing, array_bytes, 1);
+
+    size_t cell_length = 4 * config.channels;
+    timing = measure(config, [&]() {
+        for (uint row = 0; row < config.rows; ++row) {
+            entry.put_cell(t, array, row, array_input + row*cell_length, cell_shape, 2);
+        }
+    });
+    report(config, "put_cell", entry.name, shape, timing, array_bytes, config.rows);
+
+    timing = measure(config, [&]() {
+        for (uint row = 0; row < config.rows; ++row) {
+            free_output(entry.get_cell(t, array, row), cell_length);
+        }
+    });
+    report(config, "get_cell", entry.name, shape, timing, cell_bytes * config.rows, config.rows);
+
+    delete_table(t);
+}
+
+template <typename T>
+void benchmark_numeric(Config const& config, Entry<T> const& entry) {
+    size_t scalar_length = config.rows;
+    size_t array_length = size_t(config.rows) * 4 * config.channels;
+    unique_ptr<T[]> scalar_data(new T[scalar_length]);
+    unique_ptr<T[]> array_data(new T[array_length]);
+    for (size_t idx = 0; idx < scalar_length; ++idx) scalar_data[idx] = make_value<T>(idx);
+    for (size_t idx = 0; idx < array_length; ++idx) array_data[idx] = make_value<T>(idx);
+    benchmark_type(config, entry, scalar_data.get(), scalar_length,
+                   array_data.get(), array_length);
+}
+
+void benchmark_string(Config const& config, Entry<char*> const& entry) {
+    vector<string> storage(size_t(config.rows) * 4 * config.channels);
+    for (size_t idx = 0; idx < storage.size(); ++idx) {
+        storage[idx] = "benchmark string " + to_string(idx);
+    }
+    vector<char*> scalar_data(config.rows);
+    vector<char*> array_data(storage.size());
+    for (size_t idx = 0; idx < scalar_data.size(); ++idx) {
+        scalar_data[idx] = const_cast<char*>(storage[idx].c_str());
+    }
+    for (size_t idx = 0; idx < array_data.size(); ++idx) {
+        array_data[idx] = const_cast<char*>(storage[idx].c_str());
+    }
+    benchmark_type(config, entry, scalar_data.data(), scalar_data.size(),
+                   array_data.data(), array_data.size());
+}
+
+void benchmark_scalar_cells(Config const& config) {
+    string path = config.directory + "/casacore-benchmark-" + to_string(getpid()) + "-cells.ms";
+    Table* t = new_table_create(const_cast<char*>(path.c_str()));
+    t->markForDelete();
+    add_rows(t, config.rows);
+    char name[] = "TIME";
+    add_scalar_column_double(t, name);
+
+    auto timing = measure(config, [&]() {
+        for (uint row = 0; row < config.rows; ++row) {
+            put_cell_scalar_double(t, name, row, row);
+        }
+    });
+    report(config, "put_cell", "double", "scalar", timing,
+           config.rows * sizeof(double), config.rows);
+
+    timing = measure(config, [&]() {
+        for (uint row = 0; row < config.rows; ++row) {
+            sink += get_cell_scalar_double(t, name, row);
+        }
+    });
+    report(config, "get_cell", "double", "scalar", timing,
+           config.rows * sizeof(double), config.rows);
+
+    delete_table(t);
+}
+
+void benchmark_keywords(Config const& config) {
+    string path = config.directory + "/casacore-benchmark-" + to_string(getpid())
+                  + "-keywords.ms";
+    Table* t = new_table_create(const_cast<char*>(path.c_str()));
+    t->markForDelete();
+    char name[] = "KEYWORD";
+    char string_name[] = "STRING_KEYWORD";
+    char value[] = "the quick brown fox jumps over the lazy dog";
+    size_t calls = config.rows;
+
+    auto timing = measure(config, [&]() {
+        for (size_t idx = 0; idx < calls; ++idx) put_keyword_double(t, name, idx);
+    });
+    report(config, "put_keyword", "double", "scalar", timing, calls * sizeof(double), calls);
+
+    timing = measure(config, [&]() {
+        for (size_t idx = 0; idx < calls; ++idx) sink += get_keyword_double(t, name);
+    });
+    report(config, "get_keyword", "double", "scalar", timing, calls * sizeof(double), calls);
+
+    timing = measure(config, [&]() {
+        for (size_t idx = 0; idx < calls; ++idx) put_keyword_string(t, string_name, value);
+    });
+    report(config, "put_keyword", "string", "scalar", timing, calls * strlen(value), calls);
+
+    timing = measure(config, [&]() {
+        for (size_t idx = 0; idx < calls; ++idx) free_string(get_keyword_string(t, string_name));
+    });
+    report(config, "get_keyword", "string", "scalar", timing, calls * strlen(value), calls);
+
+    delete_table(t);
+}
+
+void benchmark_measures(Config const& config) {
+    size_t calls = config.rows;
+    double start = 4.9e9; // seconds (MJD ~56713)
+
+    Epoch epoch;
+    epoch.sys = MEpoch::UTC;
+    auto timing = measure(config, [&]() {
+        for (size_t idx = 0; idx < calls; ++idx) {
+            epoch.time = start + idx;
+            sink += convertEpoch(&epoch, MEpoch::TAI).time;
+        }
+    });
+    report(config, "convert_epoch", "UTC->TAI", "scalar", timing, 0, calls);
+
+    timing = measure(config, [&]() {
+        for (size_t idx = 0; idx < calls; ++idx) {
+            epoch.time = start + idx;
+            sink += convertEpoch(&epoch, MEpoch::TDB).time;
+        }
+    });
+    report(config, "convert_epoch", "UTC->TDB", "scalar", timing, 0, calls);
+
+    char vla[] = "VLA";
+    ReferenceFrame frame;
+    frame.epoch.hasvalue = true;
+    frame.epoch.value.sys = MEpoch::UTC;
+    frame.epoch.value.time = start;
+    frame.direction.hasvalue = false;
+    frame.position.hasvalue = observatory(&frame.position.value, vla);
+
+    Direction direction;
+    direction.sys = MDirection::J2000;
+    timing = measure(config, [&]() {
+        for (size_t idx = 0; idx < calls; ++idx) {
+            double ra = 2*M_PI*idx/calls;
+            direction.x = cos(ra)*0.5;
+            direction.y = sin(ra)*0.5;
+            direction.z = sqrt(0.75);
+            sink += convertDirection(&direction, MDirection::AZEL, &frame).z;
+        }
+    });
+    report(config, "convert_direction", "J2000->AZEL", "scalar", timing, 0, calls);
+
+    timing = measure(config, [&]() {
+        for (size_t idx = 0; idx < calls; ++idx) {
+            frame.epoch.value.time = start + idx;
+            sink += convertDirection(&direction, MDirection::AZEL, &frame).z;
+        }
+    });
+    report(config, "convert_direction", "J2000->AZEL (changing epoch)", "scalar", timing, 0,
+           calls);
+
+    Position position = frame.position.value;
+    timing = measure(config, [&]() {
+        for (size_t idx = 0; idx < calls; ++idx) {
+            sink += convertPosition(&position, MPosition::WGS84, &frame).z;
+        }
+    });
+    report(config, "convert_position", "ITRF->WGS84", "scalar", timing, 0, calls);
+}
+
+int main(int argc, char** argv) {
+    Config config;
+    for (int idx = 1; idx < argc; ++idx) {
+        string arg = argv[idx];
+        if (idx + 1 >= argc) {
+            fprintf(stderr, "missing value for %s\n", argv[idx]);
+            return 1;
+        }
+        if      (arg == "--rows")      config.rows      = atoi(argv[++idx]);
+        else if (arg == "--channels")  config.channels  = atoi(argv[++idx]);
+        else if (arg == "--repeat")    config.repeat    = atoi(argv[++idx]);
+        else if (arg == "--directory") config.directory = argv[++idx];
+        else if (arg == "--output") {
+            config.output = fopen(argv[++idx], "w");
+            if (config.output == nullptr) {
+                fprintf(stderr, "could not open %s\n", argv[idx]);
+                return 1;
+            }
+        }
+        else {
+            fprintf(stderr, "unknown argument %s\n", argv[idx]);
+            return 1;
+        }
+    }
+
+    Entry<bool> boolean = {"boolean", add_scalar_column_boolean, add_array_column_boolean,
+                           get_column_boolean, put_column_boolean,
+                           get_cell_array_boolean, put_cell_array_boolean};
+    Entry<int> integer = {"int", add_scalar_column_int, add_array_column_int,
+                          get_column_int, put_column_int,
+                          get_cell_array_int, put_cell_array_int};
+    Entry<float> single = {"float", add_scalar_column_float, add_array_column_float,
+                           get_column_float, put_column_float,
+                           get_cell_array_float, put_cell_array_float};
+    Entry<double> dbl = {"double", add_scalar_column_double, add_array_column_double,
+                         get_column_double, put_column_double,
+                         get_cell_array_double, put_cell_array_double};
+    Entry<cmplx> cplx = {"complex", add_scalar_column_complex, add_array_column_complex,
+                         get_column_complex, put_column_complex,
+                         get_cell_array_complex, put_cell_array_complex};
+    Entry<char*> str = {"string", add_scalar_column_string, add_array_column_string,
+                        get_column_string, put_column_string,
+                        get_cell_array_string, put_cell_array_string};
+
+    benchmark_numeric(config, boolean);
+    benchmark_numeric(config, integer);
+    benchmark_numeric(config, single);
+    benchmark_numeric(config, dbl);
+    benchmark_numeric(config, cplx);
+    benchmark_string(config, str);
+    benchmark_scalar_cells(config);
+    benchmark_keywords(config);
+    benchmark_measures(config);
+
+    if (config.output != stdout) {
+        fclose(config.output);
+    }
+    return 0;
+}
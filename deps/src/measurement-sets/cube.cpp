@@ -0,0 +1,372 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../tables/util.h"
+
+// Rearrange the visibilities of a measurement set into a dense (polarization, channel, baseline,
+// time) cube.
+//
+// Each row of the measurement set holds one (polarization, channel) cell for one baseline at one
+// time, and in the cube this cell is contiguous, so every row becomes a single block copy. The
+// rows are read in chunks with `getColumnRange` and the copies within each chunk can be split
+// between threads (the table itself is only ever accessed from the calling thread).
+//
+// Baselines are numbered (1,1), (1,2), ..., (1,N), (2,2), ... including the autocorrelations. A row
+// with ANTENNA1 > ANTENNA2 is stored as the conjugate baseline, with the cross-hand
+// polarizations swapped if there are four of them. The times are the sorted unique values of the
+// TIME column.
+//
+// Only one data description (spectral window) can be placed in a cube, and every (time, baseline)
+// pair must appear in at most one of the selected rows. Otherwise rows would silently overwrite
+// each other (and race with each other when the copies are threaded), so both are errors.
+
+enum FlagMode {
+    FLAG_IGNORE = 0,
+    FLAG_NAN    = 1,
+    FLAG_MASK   = 2
+};
+
+struct CubeIndex {
+    int nant;
+    vector<double> times;
+    vector<int> time_index;     // per row
+    vector<int> baseline_index; // per row (-1 if the row is skipped)
+    vector<bool> swapped;       // per row
+    size_t skipped;
+
+    int nbase() const {return nant*(nant+1)/2;}
+};
+
+Slicer row_range(uint start, uint length) {
+    return Slicer(IPosition(1, start), IPosition(1, length));
+}
+
+// Select the rows in [start, stop) with the given DATA_DESC_ID. If `ddid` is negative every row in
+// the range is selected, but they must all have the same DATA_DESC_ID.
+Table select_rows(Table const& ms, uint start, uint stop, int ddid) {
+    uint nrow = stop - start;
+    Vector<Int> ddids;
+    if (nrow > 0) {
+        ddids = ScalarColumn<Int>(ms, "DATA_DESC_ID").getColumnRange(row_range(start, nrow));
+    }
+    vector<uInt> rows;
+    for (uint row = 0; row < nrow; ++row) {
+        if (ddid < 0) {
+            if (ddids[row] != ddids[0]) {
+                throw AipsError("the rows have more than one DATA_DESC_ID, so one data "
+                                "description must be selected");
+            }
+            rows.push_back(start + row);
+        }
+        else if (ddids[row] == ddid) {
+            rows.push_back(start + row);
+        }
+    }
+    Vector<uInt> rownrs(rows.size());
+    std::copy(rows.begin(), rows.end(), rownrs.begin());
+    return ms(rownrs);
+}
+
+CubeIndex build_index(Table const& ms, Table const& selection) {
+    CubeIndex index;
+    uint nrow = selection.nrow();
+    Vector<Double> time;
+    Vector<Int> antenna1, antenna2;
+    if (nrow > 0) {
+        time = ScalarColumn<Double>(selection, "TIME").getColumn();
+        antenna1 = ScalarColumn<Int>(selection, "ANTENNA1").getColumn();
+        antenna2 = ScalarColumn<Int>(selection, "ANTENNA2").getColumn();
+    }
+
+    // Prefer the ANTENNA subtable so that the baseline numbering doesn't depend on which antennas
+    // happen to appear in the selected rows.
+    index.nant = 0;
+    if (ms.keywordSet().isDefined("ANTENNA")) {
+        index.nant = ms.keywordSet().asTable("ANTENNA").nrow();
+    }
+    if (index.nant == 0) {
+        for (uint row = 0; row < nrow; ++row) {
+            index.nant = max(index.nant, max(antenna1[row], antenna2[row]) + 1);
+        }
+    }
+
+    index.times.assign(time.begin(), time.end());
+    sort(index.times.begin(), index.times.end());
+    index.times.erase(unique(index.times.begin(), index.times.end()), index.times.end());
+
+    index.time_index.resize(nrow);
+    index.baseline_index.resize(nrow);
+    index.swapped.resize(nrow);
+    index.skipped = 0;
+    for (uint row = 0; row < nrow; ++row) {
+        auto itr = lower_bound(index.times.begin(), index.times.end(), time[row]);
+        index.time_index[row] = itr - index.times.begin();
+        int ant1 = antenna1[row];
+        int ant2 = antenna2[row];
+        index.swapped[row] = ant1 > ant2;
+        if (ant1 > ant2) swap(ant1, ant2);
+        if (ant1 < 0 || ant2 >= index.nant) {
+            index.baseline_index[row] = -1;
+            ++index.skipped;
+        }
+        else {
+            index.baseline_index[row] = ant1*index.nant - ant1*(ant1-1)/2 + (ant2-ant1);
+        }
+    }
+
+    vector<pair<size_t, uint>> cells; // (cell of the cube, row)
+    for (uint row = 0; row < nrow; ++row) {
+        if (index.baseline_index[row] < 0) continue;
+        size_t cell = size_t(index.time_index[row]) * index.nbase() + index.baseline_index[row];
+        cells.emplace_back(cell, row);
+    }
+    sort(cells.begin(), cells.end());
+    for (size_t idx = 1; idx < cells.size(); ++idx) {
+        if (cells[idx].first == cells[idx-1].first) {
+            uint row = cells[idx].second;
+            throw AipsError("more than one row has TIME " + String::toString(time[row])
+                            + " and baseline (" + String::toString(antenna1[row]) + ", "
+                            + String::toString(antenna2[row]) + ")");
+        }
+    }
+    return index;
+}
+
+// Check that every selected cell of `column` is a matrix of the same shape, and return that shape.
+// The rows are copied into the cube with a fixed stride, so if the flags are applied the cells of
+// FLAG must have the same shape too (otherwise they would be read out of bounds).
+IPosition check_cells(Table const& selection, char const* column, FlagMode mode) {
+    ROTableColumn data(selection, column);
+    if (data.columnDesc().dataType() != TpComplex) {
+        throw AipsError(String(column) + " is not a complex column");
+    }
+    unique_ptr<ROTableColumn> flag;
+    if (mode != FLAG_IGNORE) {
+        TableDesc const& desc = selection.tableDesc();
+        if (!desc.isColumn("FLAG") || desc.columnDesc("FLAG").dataType() != TpBool
+                || desc.columnDesc("FLAG").isScalar()) {
+            throw AipsError("applying the flags requires a boolean array column FLAG");
+        }
+        if (!desc.isColumn("FLAG_ROW") || desc.columnDesc("FLAG_ROW").dataType() != TpBool
+                || !desc.columnDesc("FLAG_ROW").isScalar()) {
+            throw AipsError("applying the flags requires a boolean scalar column FLAG_ROW");
+        }
+        flag.reset(new ROTableColumn(selection, "FLAG"));
+    }
+    IPosition shape;
+    for (uint row = 0; row < selection.nrow(); ++row) {
+        if (!data.isDefined(row)) {
+            throw AipsError(String(column) + " has an undefined cell");
+        }
+        IPosition cell = data.shape(row);
+        if (cell.size() != 2 || (row != 0 && !cell.isEqual(shape))) {
+            throw AipsError("the cells of " + String(column) + " must all be matrices of the "
+                            "same shape");
+        }
+        shape = cell;
+        if (flag && (!flag->isDefined(row) || !flag->shape(row).isEqual(shape))) {
+            throw AipsError("the cells of FLAG must have the same shape as the cells of "
+                            + String(column));
+        }
+    }
+    return shape;
+}
+
+struct CubeChunk {
+    Complex const* data;
+    Bool const* flag;
+    Bool const* flag_row;
+    uint first; // the index (relative to the start of the selection) of the first row
+};
+
+struct CubeOutput {
+    cmplx* cube;
+    bool* mask;
+    int npol;
+    int nchan;
+    int nbase;
+    FlagMode mode;
+};
+
+void copy_rows(CubeIndex const& index, CubeChunk const& chunk, CubeOutput const& output,
+               uint begin, uint end) {
+    size_t cell = size_t(output.npol) * output.nchan;
+    cmplx const nan(numeric_limits<float>::quiet_NaN(), numeric_limits<float>::quiet_NaN());
+    for (uint idx = begin; idx < end; ++idx) {
+        uint row = chunk.first + idx;
+        int baseline = index.baseline_index[row];
+        if (baseline < 0) continue;
+        size_t offset = (size_t(index.time_index[row]) * output.nbase + baseline) * cell;
+        cmplx* dst = output.cube + offset;
+        Complex const* src = chunk.data + idx*cell;
+        Bool const* flag = chunk.flag == nullptr ? nullptr : chunk.flag + idx*cell;
+        bool flag_row = chunk.flag_row != nullptr && chunk.flag_row[idx];
+
+        if (!index.swapped[row]) {
+            memcpy(dst, src, cell*sizeof(cmplx));
+        }
+        else {
+            for (size_t jdx = 0; jdx < cell; ++jdx) {
+                dst[jdx] = conj(src[jdx]);
+            }
+            if (output.npol == 4) {
+                for (int chan = 0; chan < output.nchan; ++chan) {
+                    swap(dst[4*chan+1], dst[4*chan+2]);
+                }
+            }
+        }
+        if (output.mode == FLAG_IGNORE) continue;
+
+        bool* mask = output.mask == nullptr ? nullptr : output.mask + offset;
+        for (size_t jdx = 0; jdx < cell; ++jdx) {
+            size_t source = jdx;
+            if (index.swapped[row] && output.npol == 4 && (jdx % 4 == 1 || jdx % 4 == 2)) {
+                source = jdx % 4 == 1 ? jdx + 1 : jdx - 1;
+            }
+            bool flagged = flag_row || (flag != nullptr && flag[source]);
+            if (output.mode == FLAG_NAN) {
+                if (flagged) dst[jdx] = nan;
+            }
+            else {
+                mask[jdx] = flagged;
+            }
+        }
+    }
+}
+
+void copy_chunk(CubeIndex const& index, CubeChunk const& chunk, CubeOutput const& output,
+                uint length, int nthreads) {
+    if (nthreads <= 1 || length < uint(nthreads)) {
+        copy_rows(index, chunk, output, 0, length);
+        return;
+    }
+    vector<thread> threads;
+    for (int idx = 0; idx < nthreads; ++idx) {
+        uint begin = size_t(length) * idx / nthreads;
+        uint end = size_t(length) * (idx+1) / nthreads;
+        threads.emplace_back(copy_rows, cref(index), cref(chunk), cref(output), begin, end);
+    }
+    for (auto& worker : threads) {
+        worker.join();
+    }
+}
+
+void fill_cube(Table const& selection, char const* column, CubeIndex const& index,
+               cmplx* cube, bool* mask, int* dims, FlagMode mode, double* times, int nthreads) {
+    CubeOutput output = {cube, mask, dims[0], dims[1], dims[2], mode};
+    std::copy(index.times.begin(), index.times.end(), times);
+
+    // cells that no row refers to are treated as flagged
+    size_t total = size_t(dims[0]) * dims[1] * dims[2] * dims[3];
+    cmplx initial = cmplx(0, 0);
+    if (output.mode == FLAG_NAN) {
+        initial = cmplx(numeric_limits<float>::quiet_NaN(), numeric_limits<float>::quiet_NaN());
+    }
+    std::fill(cube, cube + total, initial);
+    if (output.mode == FLAG_MASK) {
+        std::fill(mask, mask + total, true);
+    }
+
+    // read roughly 64 MB of visibilities at a time
+    size_t cell = size_t(dims[0]) * dims[1];
+    uint chunk_rows = max(size_t(1), (size_t(64) << 20) / max(size_t(1), cell*sizeof(cmplx)));
+    ArrayColumn<Complex> data_column(selection, column);
+    ArrayColumn<Bool> flag_column;
+    ScalarColumn<Bool> flag_row_column;
+    if (output.mode != FLAG_IGNORE) {
+        flag_column.attach(selection, "FLAG");
+        flag_row_column.attach(selection, "FLAG_ROW");
+    }
+    StatsCopy stats;
+    for (uint first = 0; first < selection.nrow(); first += chunk_rows) {
+        uint length = min(chunk_rows, uint(selection.nrow()) - first);
+        Slicer rows = row_range(first, length);
+        Array<Complex> data = data_column.getColumnRange(rows);
+        Array<Bool> flag;
+        Vector<Bool> flag_row;
+        if (output.mode != FLAG_IGNORE) {
+            flag = flag_column.getColumnRange(rows);
+            flag_row = flag_row_column.getColumnRange(rows);
+        }
+        Bool deleteData, deleteFlag, deleteFlagRow;
+        CubeChunk chunk;
+        chunk.data = data.getStorage(deleteData);
+        chunk.flag = output.mode == FLAG_IGNORE ? nullptr : flag.getStorage(deleteFlag);
+        chunk.flag_row = output.mode == FLAG_IGNORE ? nullptr
+                                                    : flag_row.getStorage(deleteFlagRow);
+        chunk.first = first;
+        copy_chunk(index, chunk, output, length, nthreads);
+        data.freeStorage(chunk.data, deleteData);
+        if (output.mode != FLAG_IGNORE) {
+            flag.freeStorage(chunk.flag, deleteFlag);
+            flag_row.freeStorage(chunk.flag_row, deleteFlagRow);
+        }
+        stats.add(length*cell*sizeof(cmplx), 0);
+    }
+}
+
+extern "C" {
+    // Both functions return an error message, or a null pointer on success.
+
+    // The FLAG and FLAG_ROW columns are only checked if they will be applied (`flag_mode`).
+    char* visibility_cube_size(Table* ms, char* column, uint start, uint stop, int ddid,
+                               int flag_mode, int* dims) {
+        STATS_SCOPE();
+        try {
+            Table selection = select_rows(*ms, start, stop, ddid);
+            IPosition shape = check_cells(selection, column, FlagMode(flag_mode));
+            CubeIndex index = build_index(*ms, selection);
+            dims[0] = selection.nrow() > 0 ? shape[0] : 0;
+            dims[1] = selection.nrow() > 0 ? shape[1] : 0;
+            dims[2] = index.nbase();
+            dims[3] = index.times.size();
+        }
+        catch (AipsError& error) {
+            return output_string(error.getMesg());
+        }
+        return nullptr;
+    }
+
+    // The cube (and the mask, if it is used) must have the dimensions returned by
+    // `visibility_cube_size`. The number of rows that were skipped because they refer to an
+    // antenna that does not exist is written to `skipped`.
+    char* fill_visibility_cube(Table* ms, char* column, uint start, uint stop, int ddid,
+                               cmplx* cube, bool* mask, int* dims, int flag_mode,
+                               double* times, int nthreads, size_t* skipped) {
+        STATS_SCOPE();
+        try {
+            Table selection = select_rows(*ms, start, stop, ddid);
+            IPosition shape = check_cells(selection, column, FlagMode(flag_mode));
+            if (selection.nrow() > 0 && (shape[0] != dims[0] || shape[1] != dims[1])) {
+                return output_string("the cube does not match the shape of " + String(column));
+            }
+            CubeIndex index = build_index(*ms, selection);
+            fill_cube(selection, column, index, cube, mask, dims, FlagMode(flag_mode), times,
+                      nthreads);
+            *skipped = index.skipped;
+        }
+        catch (AipsError& error) {
+            return output_string(error.getMesg());
+        }
+        return nullptr;
+    }
+}
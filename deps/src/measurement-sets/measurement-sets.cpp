@@ -17,8 +17,11 @@
 #include <casacore/ms/MeasurementSets.h>
 using namespace casacore;
 
+#include "../stats/stats.h"
+
 extern "C" {
     Table* new_measurement_set_create(char* path) {
+        STATS_SCOPE();
         SetupNewTable maker(path, MS::requiredTableDesc(), Table::NewNoReplace);
         MeasurementSet* ms = new MeasurementSet(maker);
         ms->createDefaultSubtables(Table::New);
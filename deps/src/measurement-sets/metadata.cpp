@@ -0,0 +1,173 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "metadata.h"
+#include "../tables/util.h"
+
+// Reading an undefined cell throws from deep within casacore, so check each cell first in order to
+// give a useful error message. `length` is the minimum length of the first axis (0 to skip this).
+template <typename T>
+void check_cell(ArrayColumn<T> const& column, uint row, char const* subtable, int length=0) {
+    String name = column.columnDesc().name();
+    if (!column.isDefined(row)) {
+        throw AipsError(name + " is undefined in row " + String::toString(row)
+                        + " of the " + subtable + " table");
+    }
+    IPosition shape = column.shape(row);
+    if (length > 0 && (shape.nelements() == 0 || shape[0] < length || shape.product() == 0)) {
+        throw AipsError(name + " has shape " + shape.toString() + " in row "
+                        + String::toString(row) + " of the " + subtable + " table");
+    }
+}
+
+Metadata::Metadata(Table const& ms) {
+    TableRecord const& keywords = ms.keywordSet();
+    Table antenna = keywords.asTable("ANTENNA");
+    Table spectral_window = keywords.asTable("SPECTRAL_WINDOW");
+    Table field = keywords.asTable("FIELD");
+    Table data_description = keywords.asTable("DATA_DESCRIPTION");
+    Table polarization = keywords.asTable("POLARIZATION");
+
+    antenna_names = ScalarColumn<String>(antenna, "NAME").getColumn();
+    ArrayColumn<Double> position(antenna, "POSITION");
+    for (uint row = 0; row < antenna.nrow(); ++row) {
+        check_cell(position, row, "ANTENNA", 3);
+        Array<Double> xyz = position(row);
+        antenna_positions.insert(antenna_positions.end(), xyz.begin(), xyz.end());
+    }
+
+    ArrayColumn<Double> chan_freq(spectral_window, "CHAN_FREQ");
+    for (uint row = 0; row < spectral_window.nrow(); ++row) {
+        check_cell(chan_freq, row, "SPECTRAL_WINDOW");
+        Array<Double> frequencies = chan_freq(row);
+        num_channels.push_back(frequencies.nelements());
+        channel_frequencies.insert(channel_frequencies.end(),
+                                   frequencies.begin(), frequencies.end());
+    }
+
+    field_names = ScalarColumn<String>(field, "NAME").getColumn();
+    ArrayColumn<Double> phase_dir(field, "PHASE_DIR");
+    for (uint row = 0; row < field.nrow(); ++row) {
+        // PHASE_DIR is a polynomial in time, but in practice only the constant term is used.
+        check_cell(phase_dir, row, "FIELD", 2);
+        Array<Double> direction = phase_dir(row);
+        field_directions.push_back(direction(IPosition(2, 0, 0)));
+        field_directions.push_back(direction(IPosition(2, 1, 0)));
+    }
+
+    ScalarColumn<Int> spw_id(data_description, "SPECTRAL_WINDOW_ID");
+    ScalarColumn<Int> pol_id(data_description, "POLARIZATION_ID");
+    for (uint row = 0; row < data_description.nrow(); ++row) {
+        data_description_spw.push_back(spw_id(row));
+        data_description_polarization.push_back(pol_id(row));
+    }
+
+    ArrayColumn<Int> corr_type(polarization, "CORR_TYPE");
+    for (uint row = 0; row < polarization.nrow(); ++row) {
+        check_cell(corr_type, row, "POLARIZATION");
+        Array<Int> types = corr_type(row);
+        num_correlations.push_back(types.nelements());
+        correlation_types.insert(correlation_types.end(), types.begin(), types.end());
+    }
+
+    subtables = {antenna, spectral_window, field, data_description, polarization};
+    for (Table& subtable : subtables) {
+        // The first call always reports a change, so we need to prime each subtable here.
+        subtable.hasDataChanged();
+        num_rows.push_back(subtable.nrow());
+    }
+}
+
+bool Metadata::changed() {
+    bool output = false;
+    for (size_t idx = 0; idx < subtables.size(); ++idx) {
+        // Don't short-circuit here or we will miss resetting the change flag on some subtables.
+        output = subtables[idx].hasDataChanged() || output;
+        // `hasDataChanged` compares modification times in whole seconds, so it misses a change made
+        // within the same second as the last check. Rows being added or removed is caught here.
+        output = subtables[idx].nrow() != num_rows[idx] || output;
+    }
+    return output;
+}
+
+template <typename T>
+void copy_vector(vector<T> const& input, T* output) {
+    StatsCopy stats;
+    memcpy(output, input.data(), input.size()*sizeof(T));
+    stats.add(input.size()*sizeof(T), 0);
+}
+
+extern "C" {
+    // Returns an error message, or a null pointer if the metadata was loaded into `output`.
+    char* new_measurement_set_metadata(Table* ms, Metadata** output) {
+        STATS_SCOPE();
+        try {
+            *output = new Metadata(*ms);
+        }
+        catch (AipsError& error) {
+            return output_string(error.getMesg());
+        }
+        return nullptr;
+    }
+
+    void delete_measurement_set_metadata(Metadata* metadata) {
+        delete metadata;
+    }
+
+    bool measurement_set_metadata_changed(Metadata* metadata) {
+        STATS_SCOPE();
+        return metadata->changed();
+    }
+
+    // Write the sizes of each of the metadata arrays so that the caller can allocate space for
+    // `measurement_set_metadata_copy`.
+    void measurement_set_metadata_sizes(Metadata* metadata, int* sizes) {
+        sizes[0] = metadata->antenna_names.size();
+        sizes[1] = metadata->num_channels.size();
+        sizes[2] = metadata->channel_frequencies.size();
+        sizes[3] = metadata->field_names.size();
+        sizes[4] = metadata->data_description_spw.size();
+        sizes[5] = metadata->num_correlations.size();
+        sizes[6] = metadata->correlation_types.size();
+    }
+
+    void measurement_set_metadata_copy(Metadata* metadata,
+                                       double* antenna_positions,
+                                       int* num_channels, double* channel_frequencies,
+                                       double* field_directions,
+                                       int* data_description_spw,
+                                       int* data_description_polarization,
+                                       int* num_correlations, int* correlation_types) {
+        STATS_SCOPE();
+        copy_vector(metadata->antenna_positions, antenna_positions);
+        copy_vector(metadata->num_channels, num_channels);
+        copy_vector(metadata->channel_frequencies, channel_frequencies);
+        copy_vector(metadata->field_directions, field_directions);
+        copy_vector(metadata->data_description_spw, data_description_spw);
+        copy_vector(metadata->data_description_polarization, data_description_polarization);
+        copy_vector(metadata->num_correlations, num_correlations);
+        copy_vector(metadata->correlation_types, correlation_types);
+    }
+
+    char** measurement_set_metadata_antenna_names(Metadata* metadata) {
+        STATS_SCOPE();
+        return output_array(metadata->antenna_names);
+    }
+
+    char** measurement_set_metadata_field_names(Metadata* metadata) {
+        STATS_SCOPE();
+        return output_array(metadata->field_names);
+    }
+}
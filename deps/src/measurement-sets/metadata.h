@@ -0,0 +1,57 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef JL_CASACORE_MEASUREMENT_SETS_METADATA_H
+#define JL_CASACORE_MEASUREMENT_SETS_METADATA_H
+
+#include <vector>
+using namespace std;
+
+#include <casacore/tables/Tables.h>
+#include <casacore/ms/MeasurementSets.h>
+using namespace casacore;
+
+// The contents of the small, standard subtables of a measurement set that are needed by nearly
+// every consumer of the visibilities. These are loaded once and then kept in memory so that the
+// subtables don't need to be reopened and reread for every chunk of data.
+//
+// Per-row values are stored in row order. Values that have a variable length per row (the channel
+// frequencies of each spectral window and the correlation types of each polarization setup) are
+// concatenated, with the length of each row stored separately.
+struct Metadata {
+    explicit Metadata(Table const& ms);
+
+    // Returns true if any of the subtables have been modified (and flushed) since the metadata was
+    // loaded. Changes made within a second of the last check can be missed, unless they add or
+    // remove rows.
+    bool changed();
+
+    Vector<String> antenna_names;
+    vector<double> antenna_positions;   // 3 x Nant (ITRF, meters)
+    vector<int>    num_channels;        // Nspw
+    vector<double> channel_frequencies; // sum(num_channels) (Hz)
+    Vector<String> field_names;
+    vector<double> field_directions;    // 2 x Nfield (radians)
+    vector<int>    data_description_spw;
+    vector<int>    data_description_polarization;
+    vector<int>    num_correlations;    // Npol
+    vector<int>    correlation_types;   // sum(num_correlations) (Stokes::StokesTypes)
+
+private:
+    vector<Table> subtables;
+    vector<uInt>  num_rows; // of each subtable when the metadata was loaded
+};
+
+#endif // JL_CASACORE_MEASUREMENT_SETS_METADATA_H
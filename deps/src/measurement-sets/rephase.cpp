@@ -0,0 +1,328 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "metadata.h"
+#include "../measures/measures.h"
+#include "../tables/util.h"
+
+// Move the phase center of every row of a measurement set to a new direction.
+//
+// The UVW coordinates of a row are the components of its baseline along the (u, v, w) axes of the
+// row's phase center. Moving the phase center rotates these axes, so the new coordinates are
+// obtained with a 3x3 rotation that only depends on the old and the new phase center. The target
+// is converted into the reference frame of the FIELD table once per unique time (so that targets
+// in time dependent frames like AZEL or SUN are tracked), and the rotation is cached for each
+// (time, field) pair.
+//
+// Each visibility is then multiplied by exp(-2πi Δw ν / c), where Δw is the change in the w
+// coordinate and ν is the frequency of the channel. The phasors are computed once per row and
+// channel, and shared between every polarization and every column that is rephased.
+//
+// Every row is validated before anything is written. The rows are then processed in chunks of
+// consecutive rows with the same DATA_DESC_ID, so that every cell in a chunk has the same shape and
+// the same channel frequencies.
+
+static double const speed_of_light = 299792458.0;
+
+// The (u, v, w) axes of a phase center, expressed in the Cartesian coordinates of its frame.
+struct UVWAxes {
+    double axes[3][3];
+
+    UVWAxes() = default;
+    UVWAxes(double longitude, double latitude) {
+        double sin_lon = sin(longitude), cos_lon = cos(longitude);
+        double sin_lat = sin(latitude),  cos_lat = cos(latitude);
+        double u[3] = {-sin_lon, cos_lon, 0};
+        double v[3] = {-sin_lat*cos_lon, -sin_lat*sin_lon, cos_lat};
+        double w[3] = {cos_lat*cos_lon, cos_lat*sin_lon, sin_lat};
+        for (int idx = 0; idx < 3; ++idx) {
+            axes[0][idx] = u[idx];
+            axes[1][idx] = v[idx];
+            axes[2][idx] = w[idx];
+        }
+    }
+};
+
+// Maps the UVW coordinates of a baseline relative to the old phase center to its UVW coordinates
+// relative to the new phase center.
+struct UVWRotation {
+    double matrix[3][3];
+
+    UVWRotation(UVWAxes const& from, UVWAxes const& to) {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                matrix[i][j] = 0;
+                for (int k = 0; k < 3; ++k) {
+                    matrix[i][j] += to.axes[i][k] * from.axes[j][k];
+                }
+            }
+        }
+    }
+
+    void apply(double* uvw) const {
+        double u = uvw[0], v = uvw[1], w = uvw[2];
+        for (int i = 0; i < 3; ++i) {
+            uvw[i] = matrix[i][0]*u + matrix[i][1]*v + matrix[i][2]*w;
+        }
+    }
+};
+
+// The reference frame of the PHASE_DIR column (J2000 unless the column says otherwise). Columns
+// with a variable reference frame are not supported.
+MDirection::Types phase_dir_frame(Table const& field) {
+    MDirection::Types type = MDirection::J2000;
+    TableRecord const& keywords = ROTableColumn(field, "PHASE_DIR").keywordSet();
+    if (keywords.isDefined("MEASINFO")) {
+        TableRecord const& measinfo = keywords.asRecord("MEASINFO");
+        if (measinfo.isDefined("Ref")) {
+            MDirection::getType(type, measinfo.asString("Ref"));
+        }
+    }
+    return type;
+}
+
+class Rephaser {
+public:
+    Rephaser(Table const& ms, Direction const& target)
+        : metadata(ms), target(getMDirection(target)) {
+        TableRecord const& keywords = ms.keywordSet();
+        frame_type = phase_dir_frame(keywords.asTable("FIELD"));
+
+        // Time dependent targets are converted as seen from the center of the array.
+        double center[3] = {0, 0, 0};
+        size_t nant = metadata.antenna_positions.size() / 3;
+        for (size_t ant = 0; ant < nant; ++ant) {
+            for (int idx = 0; idx < 3; ++idx) {
+                center[idx] += metadata.antenna_positions[3*ant+idx] / nant;
+            }
+        }
+        frame.set(MPosition(MVPosition(center[0], center[1], center[2]), MPosition::ITRF));
+        frame.set(MEpoch(Quantity(0, "s"), MEpoch::UTC));
+        convert = MDirection::Convert(this->target, MDirection::Ref(frame_type, frame));
+
+        channel_offsets.push_back(0);
+        for (int num : metadata.num_channels) {
+            channel_offsets.push_back(channel_offsets.back() + num);
+        }
+    }
+
+    // The target in the frame of the FIELD table at the given time.
+    UVWAxes const& target_axes(double time) {
+        auto itr = targets.find(time);
+        if (itr != targets.end()) return itr->second;
+        frame.resetEpoch(MEpoch(Quantity(time, "s"), MEpoch::UTC));
+        MVDirection direction = convert().getValue();
+        if (targets.empty()) first_target = direction;
+        return targets[time] = UVWAxes(direction.getLong(), direction.getLat());
+    }
+
+    UVWRotation const& rotation(double time, int field) {
+        auto key = make_pair(time, field);
+        auto itr = rotations.find(key);
+        if (itr != rotations.end()) return itr->second;
+        if (field < 0 || 2*size_t(field) >= metadata.field_directions.size()) {
+            throw AipsError("FIELD_ID " + String::toString(field) + " is not in the FIELD table");
+        }
+        UVWAxes from(metadata.field_directions[2*field], metadata.field_directions[2*field+1]);
+        return rotations.emplace(key, UVWRotation(from, target_axes(time))).first->second;
+    }
+
+    double const* frequencies(int ddid, size_t nchan) {
+        if (ddid < 0 || size_t(ddid) >= metadata.data_description_spw.size()) {
+            throw AipsError("DATA_DESC_ID " + String::toString(ddid) + " is not in the "
+                            "DATA_DESCRIPTION table");
+        }
+        int spw = metadata.data_description_spw[ddid];
+        if (spw < 0 || size_t(spw) >= metadata.num_channels.size()) {
+            throw AipsError("spectral window " + String::toString(spw) + " does not exist");
+        }
+        if (size_t(metadata.num_channels[spw]) != nchan) {
+            throw AipsError("the number of channels does not match spectral window "
+                            + String::toString(spw));
+        }
+        return metadata.channel_frequencies.data() + channel_offsets[spw];
+    }
+
+    void run(Table& ms, vector<String> const& columns) {
+        uint nrow = ms.nrow();
+        if (nrow == 0) return;
+        Vector<Double> time = ScalarColumn<Double>(ms, "TIME").getColumn();
+        Vector<Int> field_id = ScalarColumn<Int>(ms, "FIELD_ID").getColumn();
+        Vector<Int> ddid = ScalarColumn<Int>(ms, "DATA_DESC_ID").getColumn();
+        ArrayColumn<Double> uvw_column(ms, "UVW");
+        vector<ArrayColumn<Complex>> data_columns;
+        for (String const& column : columns) {
+            data_columns.emplace_back(ms, column);
+        }
+        validate(time, field_id, ddid, uvw_column, data_columns);
+
+        StatsCopy stats;
+        vector<double> delta_w;
+        vector<float> phasors;
+        uint first = 0;
+        while (first < nrow) {
+            // read roughly 64 MB of visibilities per column at a time
+            IPosition shape = data_columns.empty() ? IPosition(2, 1, 1)
+                                                   : data_columns[0].shape(first);
+            size_t cell = shape.product();
+            uint chunk_rows = max(size_t(1), (size_t(64) << 20) / (cell*sizeof(Complex)));
+            uint last = first + 1;
+            while (last < nrow && last - first < chunk_rows && ddid[last] == ddid[first]) {
+                ++last;
+            }
+            uint length = last - first;
+            Slicer rows(IPosition(1, first), IPosition(1, length));
+
+            Array<Double> uvw = uvw_column.getColumnRange(rows);
+            Bool deleteUVW;
+            Double* uvw_ptr = uvw.getStorage(deleteUVW);
+            delta_w.resize(length);
+            for (uint idx = 0; idx < length; ++idx) {
+                double* row_uvw = uvw_ptr + 3*idx;
+                double w = row_uvw[2];
+                rotation(time[first+idx], field_id[first+idx]).apply(row_uvw);
+                delta_w[idx] = row_uvw[2] - w;
+            }
+            uvw.putStorage(uvw_ptr, deleteUVW);
+            uvw_column.putColumnRange(rows, uvw);
+
+            if (!data_columns.empty()) {
+                size_t npol = shape[0];
+                size_t nchan = shape[1];
+                double const* nu = frequencies(ddid[first], nchan);
+                phasors.resize(2*length*nchan);
+                for (uint idx = 0; idx < length; ++idx) {
+                    double scale = -2*M_PI * delta_w[idx] / speed_of_light;
+                    float* phasor = phasors.data() + 2*idx*nchan;
+                    for (size_t chan = 0; chan < nchan; ++chan) {
+                        double phase = scale * nu[chan];
+                        phasor[2*chan+0] = cos(phase);
+                        phasor[2*chan+1] = sin(phase);
+                    }
+                }
+                for (auto& column : data_columns) {
+                    Array<Complex> data = column.getColumnRange(rows);
+                    Bool deleteData;
+                    Complex* data_ptr = data.getStorage(deleteData);
+                    rotate(reinterpret_cast<float*>(data_ptr), phasors.data(),
+                           length*nchan, npol);
+                    data.putStorage(data_ptr, deleteData);
+                    column.putColumnRange(rows, data);
+                    stats.add(2*length*cell*sizeof(Complex), 0);
+                }
+            }
+            first = last;
+        }
+        update_field(ms);
+    }
+
+private:
+    // Check every row (and compute every rotation) before anything is written, so that an error
+    // can't leave the measurement set partially rephased. After this the chunks of rows with the
+    // same DATA_DESC_ID are guaranteed to have a uniform cell shape.
+    void validate(Vector<Double> const& time, Vector<Int> const& field_id,
+                  Vector<Int> const& ddid, ArrayColumn<Double> const& uvw_column,
+                  vector<ArrayColumn<Complex>> const& data_columns) {
+        map<int, IPosition> shapes; // per DATA_DESC_ID
+        for (uint row = 0; row < time.nelements(); ++row) {
+            rotation(time[row], field_id[row]);
+            if (!uvw_column.isDefined(row) || uvw_column.shape(row) != IPosition(1, 3)) {
+                throw AipsError("UVW is not a 3 element vector in row " + String::toString(row));
+            }
+            for (auto const& column : data_columns) {
+                if (!column.isDefined(row)) {
+                    throw AipsError(column.columnDesc().name() + " is undefined in row "
+                                    + String::toString(row));
+                }
+                IPosition shape = column.shape(row);
+                auto itr = shapes.find(ddid[row]);
+                if (itr == shapes.end()) {
+                    if (shape.size() != 2) {
+                        throw AipsError(column.columnDesc().name() + " is not a matrix in row "
+                                        + String::toString(row));
+                    }
+                    frequencies(ddid[row], shape[1]);
+                    shapes.emplace(ddid[row], shape);
+                }
+                else if (shape != itr->second) {
+                    throw AipsError("the cells of " + column.columnDesc().name() + " do not have "
+                                    "the same shape in every row with DATA_DESC_ID "
+                                    + String::toString(ddid[row]));
+                }
+            }
+        }
+    }
+
+    // Multiply each visibility by the phasor of its row and channel. The complex arithmetic is
+    // written out by hand on interleaved floats (std::complex multiplication has a slow path for
+    // infinities and NaNs) so that the compiler can vectorize the inner loop.
+    static void rotate(float* vis, float const* phasors, size_t nphasor, size_t npol) {
+        for (size_t idx = 0; idx < nphasor; ++idx) {
+            float c = phasors[2*idx+0];
+            float s = phasors[2*idx+1];
+            float* v = vis + 2*npol*idx;
+            for (size_t pol = 0; pol < npol; ++pol) {
+                float re = v[2*pol+0];
+                float im = v[2*pol+1];
+                v[2*pol+0] = re*c - im*s;
+                v[2*pol+1] = re*s + im*c;
+            }
+        }
+    }
+
+    // Point every field at the target (as seen at the time of the first row).
+    void update_field(Table& ms) {
+        Table field = ms.keywordSet().asTable("FIELD");
+        field.reopenRW();
+        ArrayColumn<Double> phase_dir(field, "PHASE_DIR");
+        for (uint row = 0; row < field.nrow(); ++row) {
+            Array<Double> direction = phase_dir(row);
+            direction = 0.0;
+            direction(IPosition(2, 0, 0)) = first_target.getLong();
+            direction(IPosition(2, 1, 0)) = first_target.getLat();
+            phase_dir.put(row, direction);
+        }
+    }
+
+    Metadata metadata;
+    MDirection target;
+    MDirection::Types frame_type;
+    MeasFrame frame;
+    MDirection::Convert convert;
+    MVDirection first_target;
+    vector<int> channel_offsets;
+    map<double, UVWAxes> targets;
+    map<pair<double, int>, UVWRotation> rotations;
+};
+
+extern "C" {
+    // Returns an error message, or a null pointer if the measurement set was rephased.
+    char* rephase_measurement_set(Table* ms, Direction* target, char** columns, int ncolumns) {
+        STATS_SCOPE();
+        try {
+            vector<String> names(columns, columns + ncolumns);
+            Rephaser rephaser(*ms, *target);
+            rephaser.run(*ms, names);
+        }
+        catch (AipsError& error) {
+            return output_string(error.getMesg());
+        }
+        return nullptr;
+    }
+}
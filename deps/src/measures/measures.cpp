@@ -13,75 +13,10 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-#include <iostream>
-#include <casacore/measures/Measures.h>
-#include <casacore/measures/Measures/MeasFrame.h>
-#include <casacore/measures/Measures/MeasTable.h>
-#include <casacore/measures/Measures/MEpoch.h>
-#include <casacore/measures/Measures/MCEpoch.h>
-#include <casacore/measures/Measures/MDirection.h>
-#include <casacore/measures/Measures/MCDirection.h>
-#include <casacore/measures/Measures/MPosition.h>
-#include <casacore/measures/Measures/MCPosition.h>
-#include <casacore/measures/Measures/MBaseline.h>
-#include <casacore/measures/Measures/MCBaseline.h>
-
-using namespace std;
-using namespace casacore;
-
-// These structs must mirror their corresponding Julia types.
-
-struct Epoch {
-    int sys;
-    double time; // measured in seconds
-};
-
-struct Direction {
-    int sys;
-    double x; // measured in meters
-    double y; // measured in meters
-    double z; // measured in meters
-};
-
-struct Position {
-    int sys;
-    double x; // measured in meters
-    double y; // measured in meters
-    double z; // measured in meters
-};
-
-struct Baseline {
-    int sys;
-    double x; // measured in meters
-    double y; // measured in meters
-    double z; // measured in meters
-};
-
-// In some cases we will want to use Julia's nullable types. These types have an extra bool. If the
-// definition of Julia's nullable types ever changes, these definitions will need to be updated.
-//
-// NOTE: In Julia v0.6 the `isnull` field changed to `hasvalue`.
-
-struct NullableEpoch {
-    bool hasvalue;
-    Epoch value;
-};
-
-struct NullableDirection {
-    bool hasvalue;
-    Direction value;
-};
+#include <algorithm>
+#include <vector>
 
-struct NullablePosition {
-    bool hasvalue;
-    Position value;
-};
-
-struct ReferenceFrame {
-    NullableEpoch epoch;
-    NullableDirection direction;
-    NullablePosition position;
-};
+#include "measures.h"
 
 // Define conversion routines from the C++ types to the Julia types.
 
@@ -160,14 +95,64 @@ MeasFrame getMeasFrame(ReferenceFrame const& frame) {
     return mframe;
 }
 
+// Batches of measures are passed as a structure of arrays (one coordinate system shared by every
+// element, and separate arrays for each of the x, y, and z coordinates). This lets us set up a single
+// conversion engine and reuse it for every element of the batch, instead of paying for the setup
+// (and the trip through `ccall`) once per element.
+//
+// The output arrays may alias the input arrays.
+
+template <typename M>
+void convertBatch(int sys, double const* x, double const* y, double const* z, size_t N,
+                  int newsys, ReferenceFrame const& frame,
+                  double* output_x, double* output_y, double* output_z) {
+    MeasFrame mframe = getMeasFrame(frame);
+    typename M::Convert convert(typename M::Ref(sys), typename M::Ref(newsys, mframe));
+    for (size_t idx = 0; idx < N; ++idx) {
+        typename M::MVType input(x[idx], y[idx], z[idx]);
+        auto const& output = convert(input).getValue();
+        output_x[idx] = output(0);
+        output_y[idx] = output(1);
+        output_z[idx] = output(2);
+    }
+}
+
+// Times (for example the TIME column of a measurement set) tend to repeat, so each distinct time
+// is converted once with a single conversion engine and the result is looked up for every element.
+//
+// The output array may alias the input array. Every time must be finite (this is checked on the
+// Julia side) because NaN breaks the ordering used by sort, unique, and lower_bound.
+
+void convertEpochs(int sys, double const* times, size_t N, int newsys,
+                   ReferenceFrame const& frame, double* output) {
+    vector<double> unique_times(times, times + N);
+    sort(unique_times.begin(), unique_times.end());
+    unique_times.erase(unique(unique_times.begin(), unique_times.end()), unique_times.end());
+
+    MeasFrame mframe = getMeasFrame(frame);
+    MEpoch::Convert convert(MEpoch::Ref(sys), MEpoch::Ref(newsys, mframe));
+    vector<double> converted(unique_times.size());
+    for (size_t idx = 0; idx < unique_times.size(); ++idx) {
+        MVEpoch input(Quantity(unique_times[idx], "s"));
+        converted[idx] = convert(input).get("s").getValue();
+    }
+
+    for (size_t idx = 0; idx < N; ++idx) {
+        auto itr = lower_bound(unique_times.begin(), unique_times.end(), times[idx]);
+        output[idx] = converted[itr - unique_times.begin()];
+    }
+}
+
 extern "C" {
     Epoch convertEpoch(Epoch* input, int newsys) {
+        STATS_SCOPE();
         MEpoch input_epoch = getMEpoch(*input);
         MEpoch output_epoch = MEpoch::Convert(input_epoch, MEpoch::Ref(newsys))();
         return getEpoch(output_epoch);
     }
 
     Direction convertDirection(Direction* input, int newsys, ReferenceFrame* frame) {
+        STATS_SCOPE();
         MDirection input_direction = getMDirection(*input);
         MeasFrame mframe = getMeasFrame(*frame);
         MDirection::Ref ref = MDirection::Ref(newsys, mframe);
@@ -176,6 +161,7 @@ extern "C" {
     }
 
     Position convertPosition(Position* input, int newsys, ReferenceFrame* frame) {
+        STATS_SCOPE();
         MPosition input_position = getMPosition(*input);
         MeasFrame mframe = getMeasFrame(*frame);
         MPosition::Ref ref = MPosition::Ref(newsys, mframe);
@@ -184,6 +170,7 @@ extern "C" {
     }
 
     Baseline convertBaseline(Baseline* input, int newsys, ReferenceFrame* frame) {
+        STATS_SCOPE();
         MBaseline input_baseline = getMBaseline(*input);
         MeasFrame mframe = getMeasFrame(*frame);
         MBaseline::Ref ref = MBaseline::Ref(newsys, mframe);
@@ -191,7 +178,35 @@ extern "C" {
         return getBaseline(output_baseline);
     }
 
+    void convertEpochBatch(int sys, double* times, size_t N, int newsys, ReferenceFrame* frame,
+                           double* output) {
+        STATS_SCOPE();
+        convertEpochs(sys, times, N, newsys, *frame, output);
+    }
+
+    void convertDirectionBatch(int sys, double* x, double* y, double* z, size_t N,
+                               int newsys, ReferenceFrame* frame,
+                               double* output_x, double* output_y, double* output_z) {
+        STATS_SCOPE();
+        convertBatch<MDirection>(sys, x, y, z, N, newsys, *frame, output_x, output_y, output_z);
+    }
+
+    void convertPositionBatch(int sys, double* x, double* y, double* z, size_t N,
+                              int newsys, ReferenceFrame* frame,
+                              double* output_x, double* output_y, double* output_z) {
+        STATS_SCOPE();
+        convertBatch<MPosition>(sys, x, y, z, N, newsys, *frame, output_x, output_y, output_z);
+    }
+
+    void convertBaselineBatch(int sys, double* x, double* y, double* z, size_t N,
+                              int newsys, ReferenceFrame* frame,
+                              double* output_x, double* output_y, double* output_z) {
+        STATS_SCOPE();
+        convertBatch<MBaseline>(sys, x, y, z, N, newsys, *frame, output_x, output_y, output_z);
+    }
+
     bool observatory(Position* position, char* name) {
+        STATS_SCOPE();
         MPosition mposition;
         bool found = MeasTable::Observatory(mposition, name);
         Vector<Double> vec = mposition.getValue().getVector();
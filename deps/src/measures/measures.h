@@ -0,0 +1,102 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef JL_CASACORE_MEASURES_MEASURES_H
+#define JL_CASACORE_MEASURES_MEASURES_H
+
+#include <iostream>
+#include <casacore/measures/Measures.h>
+#include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/measures/Measures/MeasTable.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MCEpoch.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MCDirection.h>
+#include <casacore/measures/Measures/MPosition.h>
+#include <casacore/measures/Measures/MCPosition.h>
+#include <casacore/measures/Measures/MBaseline.h>
+#include <casacore/measures/Measures/MCBaseline.h>
+
+using namespace std;
+using namespace casacore;
+
+#include "../stats/stats.h"
+
+// These structs must mirror their corresponding Julia types.
+
+struct Epoch {
+    int sys;
+    double time; // measured in seconds
+};
+
+struct Direction {
+    int sys;
+    double x; // measured in meters
+    double y; // measured in meters
+    double z; // measured in meters
+};
+
+struct Position {
+    int sys;
+    double x; // measured in meters
+    double y; // measured in meters
+    double z; // measured in meters
+};
+
+struct Baseline {
+    int sys;
+    double x; // measured in meters
+    double y; // measured in meters
+    double z; // measured in meters
+};
+
+// In some cases we will want to use Julia's nullable types. These types have an extra bool. If the
+// definition of Julia's nullable types ever changes, these definitions will need to be updated.
+//
+// NOTE: In Julia v0.6 the `isnull` field changed to `hasvalue`.
+
+struct NullableEpoch {
+    bool hasvalue;
+    Epoch value;
+};
+
+struct NullableDirection {
+    bool hasvalue;
+    Direction value;
+};
+
+struct NullablePosition {
+    bool hasvalue;
+    Position value;
+};
+
+struct ReferenceFrame {
+    NullableEpoch epoch;
+    NullableDirection direction;
+    NullablePosition position;
+};
+
+Epoch getEpoch(MEpoch const& mepoch);
+Direction getDirection(MDirection const& mdirection);
+Position getPosition(MPosition const& mposition);
+Baseline getBaseline(MBaseline const& mbaseline);
+
+MEpoch getMEpoch(Epoch const& epoch);
+MDirection getMDirection(Direction const& direction);
+MPosition getMPosition(Position const& position);
+MBaseline getMBaseline(Baseline const& baseline);
+MeasFrame getMeasFrame(ReferenceFrame const& frame);
+
+#endif // JL_CASACORE_MEASURES_MEASURES_H
@@ -0,0 +1,241 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+using namespace std;
+
+#include "../stats/stats.h"
+
+// Bulk conversion between sexagesimal strings and angles (in radians). Source catalogs can contain
+// hundreds of thousands of positions, so these avoid allocating anything per element.
+//
+// The following formats are understood (the sign is optional except where noted):
+//
+// * -12h34m56.7s, 12h34.5m, 12.5h, .5h (hours)
+// * +12d34m56.7s, 12d34.5m, 12.5d, .5d (degrees)
+// * 12:34:56.7, 12:34 (hours, unsigned and less than 24h)
+// * +12.34.56.7, 12.34.56 (degrees)
+//
+// The colon separated format is only accepted for right ascensions. A declination such as
+// "-30:00:00" is rejected rather than silently read as -30h.
+
+enum SexagesimalStatus {
+    SEXAGESIMAL_OK = 0,
+    SEXAGESIMAL_INVALID = 1
+};
+
+// The width of each string written by `format_sexagesimal`. This is large enough for any finite
+// angle.
+static const int sexagesimal_width = 48;
+
+// Scan a decimal number and return a pointer to the first character following the number, or
+// `nullptr` if there is no number here. This accepts the same numbers as `\d*\.?\d+` in the
+// regular expression used by `sexagesimal(str)` in Julia (so ".5" is a number but "5." is not).
+static bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static char const* scan_number(char const* str) {
+    char const* start = str;
+    while (is_digit(*str)) ++str;
+    if (*str == '.' && is_digit(str[1])) {
+        ++str;
+        while (is_digit(*str)) ++str;
+    }
+    return str == start ? nullptr : str;
+}
+
+// Scan an unsigned integer. See `scan_number`.
+static char const* scan_integer(char const* str) {
+    char const* start = str;
+    while (is_digit(*str)) ++str;
+    return str == start ? nullptr : str;
+}
+
+static double to_double(char const* start) {
+    return strtod(start, nullptr);
+}
+
+static bool parse_one(char const* str, double* output) {
+    while (isspace(static_cast<unsigned char>(*str))) ++str;
+    double sign = +1;
+    bool has_sign = *str == '+' || *str == '-';
+    if (has_sign) {
+        sign = *str == '-' ? -1 : +1;
+        ++str;
+    }
+
+    // The first component is common to every format, but the dotted format requires an integer
+    // here. So scan an integer first and then check whether the next character is a dot.
+    char const* first = str;
+    char const* end = scan_integer(str);
+    bool dotted = end != nullptr && end[0] == '.' && is_digit(end[1]);
+    if (dotted) {
+        char const* second = end + 1;
+        char const* second_end = scan_integer(second);
+        if (*second_end == '.' && is_digit(second_end[1])) {
+            // dd.mm.ss(.s)
+            char const* third = second_end + 1;
+            char const* third_end = scan_number(third);
+            char const* tail = third_end;
+            while (isspace(static_cast<unsigned char>(*tail))) ++tail;
+            if (*tail != '\0') return false;
+            double degrees = to_double(first) + to_double(second)/60 + to_double(third)/3600;
+            *output = sign*degrees * (M_PI/180);
+            return true;
+        }
+        // otherwise this is a decimal number in one of the other formats
+    }
+
+    end = scan_number(first);
+    if (end == nullptr) return false;
+    double value = to_double(first);
+    double minutes = 0, seconds = 0;
+    bool hours;
+
+    if (*end == 'h' || *end == 'd') {
+        hours = *end == 'h';
+        str = end + 1;
+        char const* next = scan_number(str);
+        if (next != nullptr && *next == 'm') {
+            minutes = to_double(str);
+            str = next + 1;
+            next = scan_number(str);
+            if (next != nullptr && *next == 's') {
+                seconds = to_double(str);
+                str = next + 1;
+            }
+        }
+    }
+    else if (*end == ':') {
+        // hh:mm:ss(.s) is always a right ascension, so a sign or an out of range component means
+        // this is probably a declination that we would otherwise misread by a factor of 15
+        if (has_sign) return false;
+        hours = true;
+        str = end + 1;
+        char const* next = scan_number(str);
+        if (next == nullptr) return false;
+        minutes = to_double(str);
+        str = next;
+        if (*str == ':') {
+            ++str;
+            next = scan_number(str);
+            if (next == nullptr) return false;
+            seconds = to_double(str);
+            str = next;
+        }
+        if (value >= 24 || minutes >= 60 || seconds >= 60) return false;
+    }
+    else {
+        return false;
+    }
+
+    while (isspace(static_cast<unsigned char>(*str))) ++str;
+    if (*str != '\0') return false;
+
+    // Mirror the order of operations used by `sexagesimal(str)` in Julia.
+    minutes += seconds/60;
+    value += minutes/60;
+    double degrees = hours ? 15*value : value;
+    *output = sign*degrees * (M_PI/180);
+    return true;
+}
+
+// Round to the given number of decimal places (mirroring `round(x, digits)` in Julia 0.6, which
+// rounds ties to even).
+static double round_digits(double x, int digits) {
+    double p = pow(10.0, digits);
+    double r = nearbyint(x * p) / p;
+    return isfinite(r) ? r : x;
+}
+
+// Mirrors `sexagesimal(angle; hours, digits)` in Julia. For hours the angle must already be reduced
+// to [0, 2π) because Julia's `mod2pi` is more precise than we can easily reproduce here.
+static int format_one(double radians, bool hours, int digits, char* output) {
+    double s;
+    if (hours) {
+        s = +1;
+    }
+    else {
+        s = radians > 0 ? +1 : radians < 0 ? -1 : 0;
+        radians = fabs(radians);
+    }
+    int length = 0;
+    double value;
+    long long q1;
+    if (hours) {
+        value = radians * 12/M_PI;
+        value = round_digits(value*3600, digits) / 3600;
+        q1 = floor(value);
+        length += snprintf(output, sexagesimal_width, "%s%lldh", s < 0 ? "-" : "", q1);
+    }
+    else {
+        value = radians * 180/M_PI;
+        value = round_digits(value*3600, digits) / 3600;
+        q1 = floor(value);
+        length += snprintf(output, sexagesimal_width, "%s%lldd",
+                           s > 0 ? "+" : s < 0 ? "-" : "", q1);
+    }
+    value = (value - q1) * 60;
+    long long q2 = floor(value);
+    length += snprintf(output + length, sexagesimal_width - length, "%02lldm", q2);
+    value = (value - q2) * 60;
+    double q3 = round_digits(value, digits);
+    char seconds[32];
+    snprintf(seconds, sizeof(seconds), "%016.13f", q3);
+    // remove the extra decimal places, but be sure to remove the decimal point if we are removing
+    // all of the decimal places
+    int keep = digits == 0 ? 2 : digits + 3;
+    memcpy(output + length, seconds, keep);
+    length += keep;
+    output[length++] = 's';
+    return length;
+}
+
+extern "C" {
+    // Parse `N` sexagesimal strings. Elements that cannot be parsed are set to NaN and have their
+    // status set to SEXAGESIMAL_INVALID.
+    void parse_sexagesimal(char** strings, size_t N, double* output, int* status) {
+        STATS_SCOPE();
+        for (size_t idx = 0; idx < N; ++idx) {
+            if (parse_one(strings[idx], output + idx)) {
+                status[idx] = SEXAGESIMAL_OK;
+            }
+            else {
+                output[idx] = numeric_limits<double>::quiet_NaN();
+                status[idx] = SEXAGESIMAL_INVALID;
+            }
+        }
+    }
+
+    // Format `N` angles as sexagesimal strings. String `i` is written (without a terminating null
+    // character) to `output + i*sexagesimal_width` and its length is written to `lengths[i]`.
+    void format_sexagesimal(double* angles, size_t N, bool hours, int digits,
+                            char* output, int* lengths) {
+        STATS_SCOPE();
+        for (size_t idx = 0; idx < N; ++idx) {
+            lengths[idx] = format_one(angles[idx], hours, digits, output + idx*sexagesimal_width);
+        }
+    }
+
+    int sexagesimal_string_width() {
+        return sexagesimal_width;
+    }
+}
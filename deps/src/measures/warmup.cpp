@@ -0,0 +1,95 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "measures.h"
+#include <casacore/measures/Measures/MeasIERS.h>
+#include <casacore/measures/Measures/MeasJPL.h>
+
+// CasaCore opens and parses its data tables (leap seconds, IERS Earth orientation parameters, JPL
+// ephemerides, and the observatory list) the first time each one is needed, and then keeps them
+// open for the lifetime of the process. Touching every table up front moves that cost out of the
+// first conversion.
+
+// This struct must mirror `Measures.WarmupReport`.
+struct WarmupReport {
+    bool leap_seconds;
+    bool iers;
+    bool ephemerides;
+    bool observatories;
+    bool conversions;
+};
+
+bool warmup_leap_seconds(double mjd) {
+    // TAI-UTC has been non-zero since 1961, so a zero here means the table could not be read
+    return MeasTable::dUTC(mjd) != 0;
+}
+
+bool warmup_iers(double mjd) {
+    // a date past the end of the measured table falls back to the predicted table
+    Double value;
+    bool measured  = MeasIERS::get(value, MeasIERS::MEASURED,  MeasIERS::dUT1, mjd);
+    bool predicted = MeasIERS::get(value, MeasIERS::PREDICTED, MeasIERS::dUT1, mjd);
+    return measured || predicted;
+}
+
+bool warmup_ephemerides(double mjd) {
+    Vector<Double> value;
+    MVEpoch epoch(mjd);
+    bool de200 = MeasJPL::get(value, MeasJPL::DE200, MeasJPL::EARTH, epoch);
+    bool de405 = MeasJPL::get(value, MeasJPL::DE405, MeasJPL::EARTH, epoch);
+    return de200 && de405;
+}
+
+bool warmup_observatories() {
+    return MeasTable::Observatories().nelements() > 0;
+}
+
+bool warmup_conversions(double mjd) {
+    // Convert through every kind of time and a full celestial to topocentric chain of directions,
+    // which primes the precession, nutation, aberration, and Earth orientation caches.
+    MPosition position;
+    if (!MeasTable::Observatory(position, "VLA")) {
+        position = MPosition(MVPosition(-1601185.4, -5041977.5, 3554875.9), MPosition::ITRF);
+    }
+    MEpoch epoch(MVEpoch(mjd), MEpoch::UTC);
+    MeasFrame frame(epoch, position);
+    // missing data tables usually only produce a warning, but don't let an exception escape into
+    // Julia if they don't
+    try {
+        for (int sys = MEpoch::LAST; sys < MEpoch::N_Types; ++sys) {
+            MEpoch::Convert(epoch, MEpoch::Ref(sys, frame))();
+        }
+        MDirection sun(MDirection::SUN);
+        MDirection j2000 = MDirection::Convert(sun, MDirection::Ref(MDirection::J2000, frame))();
+        MDirection azel  = MDirection::Convert(j2000, MDirection::Ref(MDirection::AZEL, frame))();
+        MDirection::Convert(azel, MDirection::Ref(MDirection::B1950, frame))();
+        MPosition::Convert(position, MPosition::Ref(MPosition::WGS84, frame))();
+    }
+    catch (AipsError&) {
+        return false;
+    }
+    return true;
+}
+
+extern "C" {
+    void measures_warmup(double mjd, WarmupReport* report) {
+        STATS_SCOPE();
+        report->leap_seconds  = warmup_leap_seconds(mjd);
+        report->iers          = warmup_iers(mjd);
+        report->ephemerides   = warmup_ephemerides(mjd);
+        report->observatories = warmup_observatories();
+        report->conversions   = warmup_conversions(mjd);
+    }
+}
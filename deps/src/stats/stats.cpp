@@ -0,0 +1,108 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+#include "stats.h"
+
+using namespace std;
+
+static bool stats_enabled_from_environment() {
+    char const* value = getenv("CASACORE_JL_STATS");
+    return value != nullptr && value[0] != '\0' && value[0] != '0';
+}
+
+atomic<bool> stats_enabled(stats_enabled_from_environment());
+
+StatsEntry*& stats_current() {
+    static thread_local StatsEntry* current = nullptr;
+    return current;
+}
+
+// The registry is only locked when an entry is first used (or when the statistics are read), so
+// it does not affect the cost of an instrumented call.
+
+static mutex& registry_mutex() {
+    static mutex m;
+    return m;
+}
+
+static vector<StatsEntry*>& registry() {
+    static vector<StatsEntry*> entries;
+    return entries;
+}
+
+StatsEntry::StatsEntry(char const* name)
+        : name(name), calls(0), bytes(0), total_ns(0), copy_ns(0), allocations(0) {
+    lock_guard<mutex> guard(registry_mutex());
+    registry().push_back(this);
+}
+
+void StatsEntry::reset() {
+    calls = 0;
+    bytes = 0;
+    total_ns = 0;
+    copy_ns = 0;
+    allocations = 0;
+}
+
+// This struct must mirror its corresponding Julia type.
+
+struct StatsRecord {
+    char const* name;
+    uint64_t calls;
+    uint64_t bytes;
+    uint64_t total_ns;
+    uint64_t copy_ns;
+    uint64_t allocations;
+};
+
+extern "C" {
+    void stats_enable(bool enable) {
+        stats_enabled = enable;
+    }
+
+    bool stats_is_enabled() {
+        return stats_enabled;
+    }
+
+    void stats_reset() {
+        lock_guard<mutex> guard(registry_mutex());
+        for (auto entry : registry()) {
+            entry->reset();
+        }
+    }
+
+    int stats_num_entries() {
+        lock_guard<mutex> guard(registry_mutex());
+        return registry().size();
+    }
+
+    bool stats_get_entry(int index, StatsRecord* record) {
+        lock_guard<mutex> guard(registry_mutex());
+        if (index < 0 || index >= int(registry().size())) {
+            return false;
+        }
+        auto entry = registry()[index];
+        record->name = entry->name;
+        record->calls = entry->calls;
+        record->bytes = entry->bytes;
+        record->total_ns = entry->total_ns;
+        record->copy_ns = entry->copy_ns;
+        record->allocations = entry->allocations;
+        return true;
+    }
+}
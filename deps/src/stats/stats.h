@@ -0,0 +1,115 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef JL_CASACORE_STATS_STATS_H
+#define JL_CASACORE_STATS_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Opt-in instrumentation of the entry points that are called from Julia.
+//
+// Every instrumented entry point owns a `StatsEntry` that counts the number of calls, the total
+// time spent in the call, the time spent copying data between casacore and C arrays (in util.h),
+// the number of bytes copied, and the number of allocations made while copying. The time spent in
+// casacore itself is the difference between the total time and the copying time.
+//
+// Instrumentation is disabled by default. When it is disabled the only cost is a relaxed atomic
+// load at the start of each call. It can be enabled from Julia (`CasaCore.enable_stats()`) or by
+// setting the environment variable CASACORE_JL_STATS=1 before the library is loaded.
+
+struct StatsEntry {
+    char const* name;
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> total_ns;
+    std::atomic<uint64_t> copy_ns;
+    std::atomic<uint64_t> allocations;
+    explicit StatsEntry(char const* name); // registers the entry (see stats.cpp)
+    void reset();
+};
+
+extern std::atomic<bool> stats_enabled;
+
+inline bool stats_active() {
+    return stats_enabled.load(std::memory_order_relaxed);
+}
+
+inline uint64_t stats_now() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+// The entry point currently executing on this thread (so that copies can be attributed to it).
+StatsEntry*& stats_current();
+
+// Times an entire call to an entry point.
+class StatsScope {
+    StatsEntry* entry;
+    StatsEntry* previous;
+    uint64_t start;
+public:
+    explicit StatsScope(StatsEntry& e) : entry(nullptr), previous(nullptr), start(0) {
+        if (stats_active()) {
+            entry = &e;
+            previous = stats_current();
+            stats_current() = entry;
+            entry->calls.fetch_add(1, std::memory_order_relaxed);
+            start = stats_now();
+        }
+    }
+    ~StatsScope() {
+        if (entry) {
+            entry->total_ns.fetch_add(stats_now() - start, std::memory_order_relaxed);
+            stats_current() = previous;
+        }
+    }
+};
+
+// Times a copy between casacore and C arrays. Nested copies (for example each string copied while
+// copying an array of strings) are attributed to the outermost copy only.
+class StatsCopy {
+    StatsEntry* entry;
+    uint64_t start;
+public:
+    StatsCopy() : entry(nullptr), start(0) {
+        if (stats_active() && stats_current()) {
+            entry = stats_current();
+            stats_current() = nullptr;
+            start = stats_now();
+        }
+    }
+    ~StatsCopy() {
+        if (entry) {
+            entry->copy_ns.fetch_add(stats_now() - start, std::memory_order_relaxed);
+            stats_current() = entry;
+        }
+    }
+    void add(size_t bytes, size_t allocations) {
+        if (entry) {
+            entry->bytes.fetch_add(bytes, std::memory_order_relaxed);
+            entry->allocations.fetch_add(allocations, std::memory_order_relaxed);
+        }
+    }
+};
+
+// Place this macro at the top of each entry point. The entry is named after the enclosing function.
+#define STATS_SCOPE() \
+    static StatsEntry stats_entry_(__func__); \
+    StatsScope stats_scope_(stats_entry_)
+
+#endif // JL_CASACORE_STATS_STATS_H
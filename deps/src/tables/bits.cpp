@@ -0,0 +1,142 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "util.h"
+
+// Boolean columns (most importantly FLAG and FLAG_ROW) are stored by casacore as one byte per
+// element. Julia's BitArray stores one bit per element in a vector of 64-bit chunks, where bit `j`
+// of chunk `i` holds element `64i + j` (in column-major order). Here we convert between the two
+// representations so that boolean columns can be transferred without ever holding a full byte-per-
+// element copy of the column on the Julia side.
+//
+// The column is processed in blocks of rows so that casacore only needs to materialize one block
+// at a time. The number of rows in each block is a multiple of 64, so every block starts on a chunk
+// boundary.
+
+static const uint rows_per_block = 64*256;
+
+// Pack `N` booleans into `output`, which must have space for `ceil(N/64)` chunks. Any unused bits in
+// the final chunk are cleared.
+static void pack_bits(Bool const* input, size_t N, uint64_t* output) {
+    size_t idx = 0;
+#ifdef __SSE2__
+    for (; idx + 64 <= N; idx += 64) {
+        uint64_t chunk = 0;
+        for (int jdx = 0; jdx < 4; ++jdx) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + idx + 16*jdx));
+            // Bools are 0 or 1, so shift the low bit of each byte into the sign bit for movemask.
+            uint64_t bits = _mm_movemask_epi8(_mm_slli_epi16(bytes, 7)) & 0xffff;
+            chunk |= bits << (16*jdx);
+        }
+        output[idx/64] = chunk;
+    }
+#endif
+    for (; idx < N; idx += 64) {
+        size_t length = min<size_t>(64, N - idx);
+        uint64_t chunk = 0;
+        for (size_t jdx = 0; jdx < length; ++jdx) {
+            chunk |= uint64_t(input[idx + jdx] != 0) << jdx;
+        }
+        output[idx/64] = chunk;
+    }
+}
+
+// Unpack `N` booleans from `input` (the inverse of `pack_bits`).
+static void unpack_bits(uint64_t const* input, size_t N, Bool* output) {
+    size_t idx = 0;
+#ifdef __SSE2__
+    // Each byte of `select` picks out one bit of the (broadcast) input byte.
+    __m128i const select = _mm_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+    __m128i const one = _mm_set1_epi8(1);
+    for (; idx + 16 <= N; idx += 16) {
+        uint64_t bits = (input[idx/64] >> (idx % 64)) & 0xffff;
+        __m128i bytes = _mm_set_epi64x((bits >> 8)*0x0101010101010101,
+                                       (bits & 0xff)*0x0101010101010101);
+        bytes = _mm_cmpeq_epi8(_mm_and_si128(bytes, select), select);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + idx), _mm_and_si128(bytes, one));
+    }
+#endif
+    for (; idx < N; ++idx) {
+        output[idx] = (input[idx/64] >> (idx % 64)) & 1;
+    }
+}
+
+static void get_column_bits_impl(Table* t, char const* name, uint64_t* output) {
+    auto column_description = t->tableDesc().columnDesc(name);
+    uint nrow = t->nrow();
+    for (uint row = 0; row < nrow; row += rows_per_block) {
+        uint length = min(rows_per_block, nrow - row);
+        Slicer slicer(IPosition(1, row), IPosition(1, length));
+        Array<Bool> values;
+        if (column_description.isScalar()) {
+            values.reference(ScalarColumn<Bool>(*t, name).getColumnRange(slicer));
+        }
+        else {
+            values.reference(ArrayColumn<Bool>(*t, name).getColumnRange(slicer));
+        }
+        // The block starts on a chunk boundary, because `row` is a multiple of 64.
+        size_t offset = values.nelements() / length * row / 64;
+        StatsCopy stats;
+        Bool delete_it;
+        Bool const* storage = values.getStorage(delete_it);
+        pack_bits(storage, values.nelements(), output + offset);
+        values.freeStorage(storage, delete_it);
+        stats.add((values.nelements()+7)/8, 0);
+    }
+}
+
+static void put_column_bits_impl(Table* t, char const* name, uint64_t const* input,
+                                 int const* dims, int ndim) {
+    auto column_description = t->tableDesc().columnDesc(name);
+    uint nrow = dims[ndim-1];
+    IPosition shape = create_shape(dims, ndim);
+    for (uint row = 0; row < nrow; row += rows_per_block) {
+        uint length = min(rows_per_block, nrow - row);
+        Slicer slicer(IPosition(1, row), IPosition(1, length));
+        shape[ndim-1] = length;
+        Array<Bool> values(shape);
+        size_t offset = values.nelements() / length * row / 64;
+        {
+            StatsCopy stats;
+            unpack_bits(input + offset, values.nelements(), values.data());
+            stats.add((values.nelements()+7)/8, 0);
+        }
+        if (column_description.isScalar()) {
+            Vector<Bool> vector(values);
+            ScalarColumn<Bool>(*t, name).putColumnRange(slicer, vector);
+        }
+        else {
+            ArrayColumn<Bool>(*t, name).putColumnRange(slicer, values);
+        }
+    }
+}
+
+extern "C" {
+    // `output` must have space for `ceil(N/64)` chunks where N is the total number of elements in
+    // the column.
+    void get_column_bits(Table* t, char* name, uint64_t* output) {
+        STATS_SCOPE();
+        get_column_bits_impl(t, name, output);
+    }
+
+    void put_column_bits(Table* t, char* name, uint64_t* input, int* dims, int ndim) {
+        STATS_SCOPE();
+        put_column_bits_impl(t, name, input, dims, ndim);
+    }
+}
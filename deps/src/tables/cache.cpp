@@ -0,0 +1,148 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <climits>
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "util.h"
+
+// Opening a table is expensive. The table.dat file and the headers of every storage manager need to
+// be read before we can do anything. Services that answer many small queries against the same
+// tables can therefore spend most of their time opening and closing tables.
+//
+// casacore::Table is reference counted and every copy refers to the same underlying table. So we
+// keep a copy of each recently opened table here, and hand out new references to it instead of
+// reopening the table from disk. Julia is free to delete its reference as usual because the cache
+// still holds its own. The least recently used tables are closed once the cache is full.
+//
+// Note that a cached table with NoLocking (or a permanent lock) will not see changes made by other
+// processes. Entries can be explicitly removed with `table_cache_invalidate`.
+//
+// Deleting a reference handed out by the cache does not close the table, so pending changes would
+// not be written and the lock would never be released. References obtained from the cache must
+// therefore be released with `delete_cached_table` instead of `delete_table`.
+
+class TableCache {
+    typedef pair<string, Table> Entry;
+
+    mutex guard;
+    size_t capacity = 16;
+    list<Entry> entries; // most recently used first
+    unordered_map<string, list<Entry>::iterator> index;
+
+    void evict() {
+        while (entries.size() > capacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+public:
+    Table* open(string const& path, int mode, int lock_option, double interval) {
+        lock_guard<mutex> lock(guard);
+        string key = path + '\n' + to_string(mode) + '\n' + to_string(lock_option) + '\n'
+                     + to_string(interval);
+        auto itr = index.find(key);
+        if (itr != index.end()) {
+            entries.splice(entries.begin(), entries, itr->second);
+            return new Table(itr->second->second);
+        }
+        TableLock table_lock(TableLock::LockOption(lock_option), interval);
+        Table table(path, table_lock, Table::TableOption(mode));
+        entries.emplace_front(key, table);
+        index[key] = entries.begin();
+        evict();
+        return new Table(table);
+    }
+
+    void invalidate(string const& path) {
+        lock_guard<mutex> lock(guard);
+        string prefix = path + '\n';
+        for (auto itr = entries.begin(); itr != entries.end(); ) {
+            if (itr->first.compare(0, prefix.size(), prefix) == 0) {
+                index.erase(itr->first);
+                itr = entries.erase(itr);
+            }
+            else {
+                ++itr;
+            }
+        }
+    }
+
+    void clear() {
+        lock_guard<mutex> lock(guard);
+        index.clear();
+        entries.clear();
+    }
+
+    void resize(size_t new_capacity) {
+        lock_guard<mutex> lock(guard);
+        capacity = new_capacity;
+        evict();
+    }
+
+    size_t size() {
+        lock_guard<mutex> lock(guard);
+        return entries.size();
+    }
+};
+
+static TableCache cache;
+
+// The cache is keyed by the canonical path so that different spellings of the same path (relative
+// paths, symbolic links, trailing slashes, etc.) share the same entry.
+static string canonical_path(char const* path) {
+    char resolved[PATH_MAX];
+    if (realpath(path, resolved) == nullptr) {
+        return string(path);
+    }
+    return string(resolved);
+}
+
+extern "C" {
+    Table* new_table_open_cached(char* path, int mode, int lock_option, double interval) {
+        STATS_SCOPE();
+        return cache.open(canonical_path(path), mode, lock_option, interval);
+    }
+
+    void delete_cached_table(Table* t) {
+        STATS_SCOPE();
+        if (t->isWritable()) {
+            t->flush();
+        }
+        t->unlock();
+        delete t;
+    }
+
+    void table_cache_invalidate(char* path) {
+        STATS_SCOPE();
+        cache.invalidate(canonical_path(path));
+    }
+
+    void table_cache_clear() {
+        STATS_SCOPE();
+        cache.clear();
+    }
+
+    void table_cache_resize(int capacity) {
+        cache.resize(capacity);
+    }
+
+    int table_cache_size() {
+        return cache.size();
+    }
+}
@@ -53,79 +53,103 @@ void putCell_array(Table* t, char const* name, uint row, T* input, int const* di
 
 extern "C" {
     bool get_cell_scalar_boolean(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_scalar<Bool>(t, name, row);
     }
     int get_cell_scalar_int(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_scalar<Int>(t, name, row);
     }
     float get_cell_scalar_float(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_scalar<Float>(t, name, row);
     }
     double get_cell_scalar_double(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_scalar<Double>(t, name, row);
     }
     cmplx get_cell_scalar_complex(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_scalar<Complex>(t, name, row);
     }
     char* get_cell_scalar_string(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         ScalarColumn<String> column(*t, name);
         return output_string(column(row));
     }
 
     void put_cell_scalar_boolean(Table* t, char* name, uint row, bool input) {
+        STATS_SCOPE();
         putCell_scalar(t, name, row, input);
     }
     void put_cell_scalar_int(Table* t, char* name, uint row, int input) {
+        STATS_SCOPE();
         putCell_scalar(t, name, row, input);
     }
     void put_cell_scalar_float(Table* t, char* name, uint row, float input) {
+        STATS_SCOPE();
         putCell_scalar(t, name, row, input);
     }
     void put_cell_scalar_double(Table* t, char* name, uint row, double input) {
+        STATS_SCOPE();
         putCell_scalar(t, name, row, input);
     }
     void put_cell_scalar_complex(Table* t, char* name, uint row, cmplx input) {
+        STATS_SCOPE();
         putCell_scalar(t, name, row, input);
     }
     void put_cell_scalar_string(Table* t, char* name, uint row, char* input) {
+        STATS_SCOPE();
         putCell_scalar(t, name, row, String(input));
     }
 
     bool* get_cell_array_boolean(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_array<Bool>(t, name, row);
     }
     int* get_cell_array_int(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_array<Int>(t, name, row);
     }
     float* get_cell_array_float(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_array<Float>(t, name, row);
     }
     double* get_cell_array_double(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_array<Double>(t, name, row);
     }
     cmplx* get_cell_array_complex(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_array<Complex>(t, name, row);
     }
     char** get_cell_array_string(Table* t, char* name, uint row) {
+        STATS_SCOPE();
         return getCell_array<String, char*>(t, name, row);
     }
 
     void put_cell_array_boolean(Table* t, char* name, uint row, bool* input, int* dims, int ndim) {
+        STATS_SCOPE();
         return putCell_array(t, name, row, input, dims, ndim);
     }
     void put_cell_array_int(Table* t, char* name, uint row, int* input, int* dims, int ndim) {
+        STATS_SCOPE();
         return putCell_array(t, name, row, input, dims, ndim);
     }
     void put_cell_array_float(Table* t, char* name, uint row, float* input, int* dims, int ndim) {
+        STATS_SCOPE();
         return putCell_array(t, name, row, input, dims, ndim);
     }
     void put_cell_array_double(Table* t, char* name, uint row, double* input, int* dims, int ndim) {
+        STATS_SCOPE();
         return putCell_array(t, name, row, input, dims, ndim);
     }
     void put_cell_array_complex(Table* t, char* name, uint row, cmplx* input, int* dims, int ndim) {
+        STATS_SCOPE();
         return putCell_array(t, name, row, input, dims, ndim);
     }
     void put_cell_array_string(Table* t, char* name, uint row, char** input, int* dims, int ndim) {
+        STATS_SCOPE();
         return putCell_array<String, char*>(t, name, row, input, dims, ndim);
     }
 }
@@ -13,7 +13,12 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
 #include "util.h"
+#include <casacore/tables/Tables/RefTable.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
 
 template <typename T>
 void addScalarColumn(Table* t, char const* name) {
@@ -21,18 +26,97 @@ void addScalarColumn(Table* t, char const* name) {
     t->addColumn(column);
 }
 
+// If `ntile` is zero the column is stored with the default storage manager. Otherwise the column
+// gets its own tiled storage manager with the given tile shape (which includes the row axis).
 template <typename T>
-void addArrayColumn(Table* t, char const* name, int const* dims, int ndim) {
+void addArrayColumn(Table* t, char const* name, int const* dims, int ndim,
+                    int const* tile, int ntile) {
     auto shape = create_shape(dims, ndim);
     ArrayColumnDesc<T> column(name, shape);
-    t->addColumn(column);
+    if (ntile == 0) {
+        t->addColumn(column);
+    }
+    else {
+        TableDesc description;
+        description.addColumn(column);
+        TiledColumnStMan manager(String("Tiled") + name, create_shape(tile, ntile));
+        t->addColumn(description, manager);
+    }
+}
+
+// Reference tables (for example a sorted table) may visit the rows of the underlying table in any
+// order. Reading a column through a reference table therefore goes cell by cell, which can be very
+// slow. Instead we read the underlying table in large blocks of contiguous rows (in the order they
+// are stored on disk) and then scatter each cell into its place in the output.
+bool isReferenceTable(Table* t) {
+    return dynamic_cast<RefTable*>(t->baseTablePtr()) != nullptr;
+}
+
+template <typename T>
+Array<T> getColumnReordered(Table* t, char const* name, ColumnDesc const& column_description) {
+    // Small gaps between the selected rows are read (and then discarded) so that the reads can be
+    // coalesced into larger blocks. This is only safe if every cell is guaranteed to have the same
+    // shape.
+    bool scalar = column_description.isScalar();
+    uint max_gap = scalar || column_description.isFixedShape() ? 64 : 0;
+
+    Table root(t->baseTablePtr()->root());
+    Vector<uInt> rows = t->rowNumbers();
+    size_t N = rows.size();
+    IPosition shape(1, N);
+    size_t cell = 1;
+    if (!scalar) {
+        IPosition cell_shape = ArrayColumn<T>(*t, name).shape(0);
+        shape.prepend(cell_shape);
+        cell = cell_shape.product();
+    }
+    // Each block is read into a temporary array, so limit the blocks to roughly 64 MB (the same as
+    // the chunks read by the visibility cube).
+    size_t max_block = max(size_t(1), (size_t(64) << 20) / max(size_t(1), cell*sizeof(T)));
+    Array<T> output(shape);
+    T* raw = output.data();
+
+    vector<size_t> order(N);
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(),
+                [&rows](size_t lhs, size_t rhs) {return rows[lhs] < rows[rhs];});
+
+    size_t idx = 0;
+    while (idx < N) {
+        uInt first = rows[order[idx]];
+        uInt last  = first;
+        size_t end = idx + 1;
+        while (end < N && rows[order[end]] <= last + max_gap + 1
+                       && rows[order[end]] - first < max_block) {
+            last = rows[order[end]];
+            ++end;
+        }
+        Slicer slicer(IPosition(1, first), IPosition(1, last - first + 1));
+        Array<T> block;
+        if (scalar) {
+            block.reference(ScalarColumn<T>(root, name).getColumnRange(slicer));
+        }
+        else {
+            block.reference(ArrayColumn<T>(root, name).getColumnRange(slicer));
+        }
+        T const* input = block.data();
+        for (; idx < end; ++idx) {
+            T const* source = input + (rows[order[idx]] - first)*cell;
+            copy(source, source + cell, raw + order[idx]*cell);
+        }
+    }
+    return output;
 }
 
 template <typename T, typename R>
 R* getColumn(Table* t, char const* name) {
     auto table_description = t->tableDesc();
     auto column_description = table_description.columnDesc(name);
-    if (column_description.isScalar()) {
+    if (isReferenceTable(t) && t->nrow() > 0) {
+        Array<T> values = getColumnReordered<T>(t, name, column_description);
+        return output_array(values);
+    }
+    else if (column_description.isScalar()) {
         ScalarColumn<T> column(*t, name);
         Vector<T> values = column.getColumn();
         return output_array(values);
@@ -72,71 +156,132 @@ void putColumn(Table* t, char const* name, T const* input, int const* dims, int
 
 extern "C" {
     uint num_columns(Table* t) {
+        STATS_SCOPE();
         return t->tableDesc().ncolumn();
     }
 
     bool column_exists(Table* t, char* columnName) {
+        STATS_SCOPE();
         return t->tableDesc().isColumn(columnName);
     }
 
     // add/remove columns
 
     void add_scalar_column_boolean(Table* t, char* name) {
+        STATS_SCOPE();
         addScalarColumn<Bool>(t, name);
     }
     void add_scalar_column_int(Table* t, char* name) {
+        STATS_SCOPE();
         addScalarColumn<Int>(t, name);
     }
     void add_scalar_column_float(Table* t, char* name) {
+        STATS_SCOPE();
         addScalarColumn<Float>(t, name);
     }
     void add_scalar_column_double(Table* t, char* name) {
+        STATS_SCOPE();
         addScalarColumn<Double>(t, name);
     }
     void add_scalar_column_complex(Table* t, char* name) {
+        STATS_SCOPE();
         addScalarColumn<Complex>(t, name);
     }
     void add_scalar_column_string(Table* t, char* name) {
+        STATS_SCOPE();
         addScalarColumn<String>(t, name);
     }
 
     void add_array_column_boolean(Table* t, char* name, int* dim, int ndim) {
-        addArrayColumn<Bool>(t, name, dim, ndim);
+        STATS_SCOPE();
+        addArrayColumn<Bool>(t, name, dim, ndim, nullptr, 0);
     }
     void add_array_column_int(Table* t, char* name, int* dim, int ndim) {
-        addArrayColumn<Int>(t, name, dim, ndim);
+        STATS_SCOPE();
+        addArrayColumn<Int>(t, name, dim, ndim, nullptr, 0);
     }
     void add_array_column_float(Table* t, char* name, int* dim, int ndim) {
-        addArrayColumn<Float>(t, name, dim, ndim);
+        STATS_SCOPE();
+        addArrayColumn<Float>(t, name, dim, ndim, nullptr, 0);
     }
     void add_array_column_double(Table* t, char* name, int* dim, int ndim) {
-        addArrayColumn<Double>(t, name, dim, ndim);
+        STATS_SCOPE();
+        addArrayColumn<Double>(t, name, dim, ndim, nullptr, 0);
     }
     void add_array_column_complex(Table* t, char* name, int* dim, int ndim) {
-        addArrayColumn<Complex>(t, name, dim, ndim);
+        STATS_SCOPE();
+        addArrayColumn<Complex>(t, name, dim, ndim, nullptr, 0);
     }
     void add_array_column_string(Table* t, char* name, int* dim, int ndim) {
-        addArrayColumn<String>(t, name, dim, ndim);
+        STATS_SCOPE();
+        addArrayColumn<String>(t, name, dim, ndim, nullptr, 0);
+    }
+    // The tiled storage managers cannot store strings so there is no string version of these.
+    void add_tiled_array_column_boolean(Table* t, char* name, int* dim, int ndim,
+                                        int* tile, int ntile) {
+        STATS_SCOPE();
+        addArrayColumn<Bool>(t, name, dim, ndim, tile, ntile);
+    }
+    void add_tiled_array_column_int(Table* t, char* name, int* dim, int ndim,
+                                    int* tile, int ntile) {
+        STATS_SCOPE();
+        addArrayColumn<Int>(t, name, dim, ndim, tile, ntile);
+    }
+    void add_tiled_array_column_float(Table* t, char* name, int* dim, int ndim,
+                                      int* tile, int ntile) {
+        STATS_SCOPE();
+        addArrayColumn<Float>(t, name, dim, ndim, tile, ntile);
+    }
+    void add_tiled_array_column_double(Table* t, char* name, int* dim, int ndim,
+                                       int* tile, int ntile) {
+        STATS_SCOPE();
+        addArrayColumn<Double>(t, name, dim, ndim, tile, ntile);
+    }
+    void add_tiled_array_column_complex(Table* t, char* name, int* dim, int ndim,
+                                        int* tile, int ntile) {
+        STATS_SCOPE();
+        addArrayColumn<Complex>(t, name, dim, ndim, tile, ntile);
     }
 
     void remove_column(Table* t, char* columnName) {
+        STATS_SCOPE();
         t->removeColumn(columnName);
     }
 
     // get/put columns
 
     bool column_is_fixed_shape(Table* t, char* name) {
+        STATS_SCOPE();
         ROTableColumn col(*t, name);
         return (col.columnDesc().options() & ColumnDesc::FixedShape) == ColumnDesc::FixedShape;
     }
 
+    // Returns the type of the data manager that stores the given column (for example
+    // "StandardStMan" or "TiledColumnStMan").
+    char* column_data_manager(Table* t, char* name) {
+        STATS_SCOPE();
+        Record info = t->dataManagerInfo();
+        for (uInt idx = 0; idx < info.nfields(); ++idx) {
+            Record manager = info.subRecord(idx);
+            Vector<String> columns = manager.asArrayString("COLUMNS");
+            for (uInt jdx = 0; jdx < columns.size(); ++jdx) {
+                if (columns[jdx] == name) {
+                    return output_string(manager.asString("TYPE"));
+                }
+            }
+        }
+        return output_string("");
+    }
+
     bool column_can_change_shape(Table* t, char* name) {
+        STATS_SCOPE();
         // if a column is not fixed shape, it still might not be able to change shape :(
         ROTableColumn col(*t, name);
         return col.canChangeShape();
     }
 
     int* column_info(Table* t, char* name, int* element_type, int* dimension) {
+        STATS_SCOPE();
         ROTableColumn col(*t, name);
         *element_type = col.columnDesc().dataType();
         if (col.columnDesc().isScalar()) {
@@ -182,40 +327,52 @@ extern "C" {
     }
 
     bool* get_column_boolean(Table* t, char* name) {
+        STATS_SCOPE();
         return getColumn<Bool>(t, name);
     }
     int* get_column_int(Table* t, char* name) {
+        STATS_SCOPE();
         return getColumn<Int>(t, name);
     }
     float* get_column_float(Table* t, char* name) {
+        STATS_SCOPE();
         return getColumn<Float>(t, name);
     }
     double* get_column_double(Table* t, char* name) {
+        STATS_SCOPE();
         return getColumn<Double>(t, name);
     }
     cmplx* get_column_complex(Table* t, char* name) {
+        STATS_SCOPE();
         return getColumn<Complex>(t, name);
     }
     char** get_column_string(Table* t, char* name) {
+        STATS_SCOPE();
         return getColumn<String, char*>(t, name);
     }
 
     void put_column_boolean(Table* t, char* name, bool* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putColumn(t, name, input, dims, ndim);
     }
     void put_column_int(Table* t, char* name, int* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putColumn(t, name, input, dims, ndim);
     }
     void put_column_float(Table* t, char* name, float* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putColumn(t, name, input, dims, ndim);
     }
     void put_column_double(Table* t, char* name, double* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putColumn(t, name, input, dims, ndim);
     }
     void put_column_complex(Table* t, char* name, cmplx* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putColumn(t, name, input, dims, ndim);
     }
     void put_column_string(Table* t, char* name, char** input, int* dims, int ndim) {
+        STATS_SCOPE();
         putColumn<String, char*>(t, name, input, dims, ndim);
     }
 }
@@ -36,15 +36,19 @@ T getKeyword(TableRecord const& keywords, char const* keyword) {
     return output;
 }
 
+// Note that `keywords` is a reference here to avoid making a copy of the entire `TableRecord` just
+// to read a single field.
+
 template <typename T>
 T getKeyword(Table* t, char const* keyword) {
-    auto keywords = t->keywordSet();
+    TableRecord const& keywords = t->keywordSet();
     return getKeyword<T>(keywords, keyword);
 }
 
 template <typename T>
 T getKeyword(Table* t, char const* column, char const* keyword) {
-    auto keywords = TableColumn(*t, column).keywordSet();
+    TableColumn col(*t, column);
+    TableRecord const& keywords = col.keywordSet();
     return getKeyword<T>(keywords, keyword);
 }
 
@@ -82,13 +86,14 @@ R* getKeyword_array(TableRecord const& keywords, char const* keyword) {
 
 template <typename T, typename R>
 R* getKeyword_array(Table* t, char const* keyword) {
-    auto keywords = t->keywordSet();
+    TableRecord const& keywords = t->keywordSet();
     return getKeyword_array<T, R>(keywords, keyword);
 }
 
 template <typename T, typename R>
 R* getKeyword_array(Table* t, char const* column, char const* keyword) {
-    auto keywords = TableColumn(*t, column).keywordSet();
+    TableColumn col(*t, column);
+    TableRecord const& keywords = col.keywordSet();
     return getKeyword_array<T, R>(keywords, keyword);
 }
 
@@ -119,210 +124,268 @@ void putKeyword_array(Table* t, char const* column, char const* keyword,
 
 extern "C" {
     uint num_keywords(Table* t) {
-        auto keywords = t->keywordSet();
+        STATS_SCOPE();
+        TableRecord const& keywords = t->keywordSet();
         return keywords.nfields();
     }
 
     bool keyword_exists(Table* t, char* keyword) {
-        auto keywords = t->keywordSet();
+        STATS_SCOPE();
+        TableRecord const& keywords = t->keywordSet();
         return keywords.isDefined(keyword);
     }
 
     bool column_keyword_exists(Table* t, char* column, char* keyword) {
-        auto keywords = TableColumn(*t, column).keywordSet();
+        STATS_SCOPE();
+        TableColumn col(*t, column);
+        TableRecord const& keywords = col.keywordSet();
         return keywords.isDefined(keyword);
     }
 
     void remove_keyword(Table* t, char* keyword) {
+        STATS_SCOPE();
         TableRecord& keywords = t->rwKeywordSet();
         keywords.removeField(keyword);
     }
 
     void remove_column_keyword(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         TableRecord& keywords = TableColumn(*t, column).rwKeywordSet();
         keywords.removeField(keyword);
     }
 
     int* keyword_info(Table* t, char* keyword, int* element_type, int* dimension) {
+        STATS_SCOPE();
         return keyword_info(t->keywordSet(), keyword, element_type, dimension);
     }
 
     int* column_keyword_info(Table* t, char* column, char* keyword,
                              int* element_type, int* dimension) {
-        return keyword_info(TableColumn(*t, column).keywordSet(), keyword,
-                            element_type, dimension);
+        STATS_SCOPE();
+        TableColumn col(*t, column);
+        return keyword_info(col.keywordSet(), keyword, element_type, dimension);
     }
 
     // Table Keywords
 
     bool get_keyword_boolean(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword<Bool>(t, keyword);
     }
     int get_keyword_int(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword<Int>(t, keyword);
     }
     float get_keyword_float(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword<Float>(t, keyword);
     }
     double get_keyword_double(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword<Double>(t, keyword);
     }
     cmplx get_keyword_complex(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword<Complex>(t, keyword);
     }
     char* get_keyword_string(Table* t, char* keyword) {
+        STATS_SCOPE();
         String string = getKeyword<String>(t, keyword);
         return output_string(string);
     }
     Table* get_keyword_table(Table* t, char* keyword) {
-        auto keywords = t->keywordSet();
+        STATS_SCOPE();
+        TableRecord const& keywords = t->keywordSet();
         Table* output = new Table(keywords.asTable(keyword));
         return output;
     }
 
     void put_keyword_boolean(Table* t, char* keyword, bool input) {
+        STATS_SCOPE();
         putKeyword(t, keyword, input);
     }
     void put_keyword_int(Table* t, char* keyword, int input) {
+        STATS_SCOPE();
         putKeyword(t, keyword, input);
     }
     void put_keyword_float(Table* t, char* keyword, float input) {
+        STATS_SCOPE();
         putKeyword(t, keyword, input);
     }
     void put_keyword_double(Table* t, char* keyword, double input) {
+        STATS_SCOPE();
         putKeyword(t, keyword, input);
     }
     void put_keyword_complex(Table* t, char* keyword, cmplx input) {
+        STATS_SCOPE();
         putKeyword(t, keyword, input);
     }
     void put_keyword_string(Table* t, char* keyword, char* input) {
+        STATS_SCOPE();
         putKeyword(t, keyword, input);
     }
     void put_keyword_table(Table* t, char* keyword, Table* input) {
+        STATS_SCOPE();
         TableRecord& keywords = t->rwKeywordSet();
         keywords.defineTable(keyword, *input);
     }
 
     bool* get_keyword_array_boolean(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<Bool, bool>(t, keyword);
     }
     int* get_keyword_array_int(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<Int, int>(t, keyword);
     }
     float* get_keyword_array_float(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<Float, float>(t, keyword);
     }
     double* get_keyword_array_double(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<Double, double>(t, keyword);
     }
     cmplx* get_keyword_array_complex(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<Complex, cmplx>(t, keyword);
     }
     char** get_keyword_array_string(Table* t, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<String, char*>(t, keyword);
     }
 
     void put_keyword_array_boolean(Table* t, char* keyword, bool* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, keyword, input, dims, ndim);
     }
     void put_keyword_array_int(Table* t, char* keyword, int* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, keyword, input, dims, ndim);
     }
     void put_keyword_array_float(Table* t, char* keyword, float* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, keyword, input, dims, ndim);
     }
     void put_keyword_array_double(Table* t, char* keyword, double* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, keyword, input, dims, ndim);
     }
     void put_keyword_array_complex(Table* t, char* keyword, cmplx* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, keyword, input, dims, ndim);
     }
     void put_keyword_array_string(Table* t, char* keyword, char** input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, keyword, input, dims, ndim);
     }
 
     // Column Keywords
 
     bool get_column_keyword_boolean(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword<Bool>(t, column, keyword);
     }
     int get_column_keyword_int(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword<Int>(t, column, keyword);
     }
     float get_column_keyword_float(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword<Float>(t, column, keyword);
     }
     double get_column_keyword_double(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword<Double>(t, column, keyword);
     }
     cmplx get_column_keyword_complex(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword<Complex>(t, column, keyword);
     }
     char* get_column_keyword_string(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         String string = getKeyword<String>(t, column, keyword);
         return output_string(string);
     }
 
     void put_column_keyword_boolean(Table* t, char* column, char* keyword, bool input) {
+        STATS_SCOPE();
         putKeyword<Bool>(t, column, keyword, input);
     }
     void put_column_keyword_int(Table* t, char* column, char* keyword, int input) {
+        STATS_SCOPE();
         putKeyword<Int>(t, column, keyword, input);
     }
     void put_column_keyword_float(Table* t, char* column, char* keyword, float input) {
+        STATS_SCOPE();
         putKeyword<Float>(t, column, keyword, input);
     }
     void put_column_keyword_double(Table* t, char* column, char* keyword, double input) {
+        STATS_SCOPE();
         putKeyword<Double>(t, column, keyword, input);
     }
     void put_column_keyword_complex(Table* t, char* column, char* keyword, cmplx input) {
+        STATS_SCOPE();
         putKeyword<Complex>(t, column, keyword, input);
     }
     void put_column_keyword_string(Table* t, char* column, char* keyword, char* input) {
+        STATS_SCOPE();
         putKeyword<String>(t, column, keyword, input);
     }
 
     bool* get_column_keyword_array_boolean(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<Bool, bool>(t, column, keyword);
     }
     int* get_column_keyword_array_int(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<Int, int>(t, column, keyword);
     }
     float* get_column_keyword_array_float(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<Float, float>(t, column, keyword);
     }
     double* get_column_keyword_array_double(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<Double, double>(t, column, keyword);
     }
     cmplx* get_column_keyword_array_complex(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<Complex, cmplx>(t, column, keyword);
     }
     char** get_column_keyword_array_string(Table* t, char* column, char* keyword) {
+        STATS_SCOPE();
         return getKeyword_array<String, char*>(t, column, keyword);
     }
 
     void put_column_keyword_array_boolean(Table* t, char* column, char* keyword,
                                           bool* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, column, keyword, input, dims, ndim);
     }
     void put_column_keyword_array_int(Table* t, char* column, char* keyword,
                                       int* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, column, keyword, input, dims, ndim);
     }
     void put_column_keyword_array_float(Table* t, char* column, char* keyword,
                                         float* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, column, keyword, input, dims, ndim);
     }
     void put_column_keyword_array_double(Table* t, char* column, char* keyword,
                                          double* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, column, keyword, input, dims, ndim);
     }
     void put_column_keyword_array_complex(Table* t, char* column, char* keyword,
                                           cmplx* input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, column, keyword, input, dims, ndim);
     }
     void put_column_keyword_array_string(Table* t, char* column, char* keyword,
                                          char** input, int* dims, int ndim) {
+        STATS_SCOPE();
         putKeyword_array(t, column, keyword, input, dims, ndim);
     }
 }
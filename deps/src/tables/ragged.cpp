@@ -0,0 +1,256 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util.h"
+
+// Columns that are not fixed shape may have a different shape in every row (for example the DATA
+// column of a measurement set with spectral windows that have different numbers of channels). These
+// columns can't be read into a single multidimensional array, so instead we transfer every cell at
+// once as
+//
+// * a table of the shape of each cell (ndim x nrow, with undefined cells having a shape of zeros),
+// * and a flat buffer with the contents of each cell concatenated in row order.
+
+template <typename T>
+void addRaggedColumn(Table* t, char const* name, int ndim) {
+    ArrayColumnDesc<T> column(name, ndim);
+    t->addColumn(column);
+}
+
+void copy_cell(Array<String> const& cell, char** output) {
+    auto itr = cell.begin();
+    for (size_t idx = 0; idx < cell.nelements(); ++idx, ++itr) {
+        output[idx] = output_string(*itr);
+    }
+}
+
+template <typename T>
+void copy_cell(Array<T> const& cell, T* output) {
+    Bool delete_it;
+    T const* storage = cell.getStorage(delete_it);
+    memcpy(output, storage, cell.nelements()*sizeof(T));
+    cell.freeStorage(storage, delete_it);
+}
+
+template <typename T, typename R>
+R* getColumnRagged(Table* t, char const* name) {
+    ArrayColumn<T> column(*t, name);
+    uint nrow = t->nrow();
+    size_t total = 0;
+    for (uint row = 0; row < nrow; ++row) {
+        if (column.isDefined(row)) {
+            total += column.shape(row).product();
+        }
+    }
+    StatsCopy stats;
+    R* output = new R[total];
+    stats.add(total*sizeof(R), 1);
+    size_t offset = 0;
+    Array<T> cell;
+    for (uint row = 0; row < nrow; ++row) {
+        if (column.isDefined(row)) {
+            // Let casacore reuse the storage of `cell` whenever the shape doesn't change.
+            column.get(row, cell, true);
+            copy_cell(cell, output + offset);
+            offset += cell.nelements();
+        }
+    }
+    return output;
+}
+
+template <typename T>
+T* getColumnRagged(Table* t, char const* name) {
+    return getColumnRagged<T, T>(t, name);
+}
+
+template <typename T, typename R>
+void putColumnRagged(Table* t, char const* name, R const* input, int const* shapes, int ndim) {
+    ArrayColumn<T> column(*t, name);
+    uint nrow = t->nrow();
+    size_t offset = 0;
+    for (uint row = 0; row < nrow; ++row) {
+        int const* dims = shapes + row*ndim;
+        auto array = input_array(input + offset, dims, ndim);
+        if (array->nelements() > 0) {
+            column.put(row, *array);
+        }
+        offset += array->nelements();
+    }
+}
+
+template <typename T>
+void putColumnRagged(Table* t, char const* name, T const* input, int const* shapes, int ndim) {
+    putColumnRagged<T, T>(t, name, input, shapes, ndim);
+}
+
+extern "C" {
+    // Returns the shape of each cell in the column. If the number of dimensions is not fixed by the
+    // column description, the largest number of dimensions is used and the remaining dimensions are
+    // padded with ones.
+    int* get_column_shapes(Table* t, char* name, int* ndim) {
+        STATS_SCOPE();
+        ROTableColumn col(*t, name);
+        uint nrow = t->nrow();
+        *ndim = col.columnDesc().ndim();
+        if (*ndim <= 0) {
+            *ndim = 1;
+            for (uint row = 0; row < nrow; ++row) {
+                if (col.isDefined(row)) {
+                    *ndim = max<int>(*ndim, col.ndim(row));
+                }
+            }
+        }
+        int* shapes = new int[(*ndim)*nrow];
+        for (uint row = 0; row < nrow; ++row) {
+            int* shape = shapes + row*(*ndim);
+            if (col.isDefined(row)) {
+                IPosition cell_shape = col.shape(row);
+                for (int idx = 0; idx < *ndim; ++idx) {
+                    shape[idx] = idx < int(cell_shape.size()) ? cell_shape[idx] : 1;
+                }
+            }
+            else {
+                fill(shape, shape + (*ndim), 0);
+            }
+        }
+        return shapes;
+    }
+
+    bool column_is_scalar(Table* t, char* name) {
+        STATS_SCOPE();
+        return t->tableDesc().columnDesc(name).isScalar();
+    }
+
+    // Returns the number of dimensions of every cell in an array column, or a value less than one
+    // if the cells may have any number of dimensions.
+    int column_ndim(Table* t, char* name) {
+        STATS_SCOPE();
+        return t->tableDesc().columnDesc(name).ndim();
+    }
+
+    // Returns the shape of a single cell. The number of dimensions is set to zero if the cell is
+    // undefined.
+    int* cell_shape(Table* t, char* name, uint row, int* ndim) {
+        STATS_SCOPE();
+        ROTableColumn col(*t, name);
+        if (!col.isDefined(row)) {
+            *ndim = 0;
+            return new int[0];
+        }
+        IPosition shape = col.shape(row);
+        *ndim = shape.size();
+        int* output = new int[*ndim];
+        for (int idx = 0; idx < *ndim; ++idx) {
+            output[idx] = shape[idx];
+        }
+        return output;
+    }
+
+    // Returns true if every cell in the column is defined and has the same shape. This needs to
+    // be true before the column can be read as a single array.
+    bool column_has_uniform_shape(Table* t, char* name) {
+        STATS_SCOPE();
+        ROTableColumn col(*t, name);
+        uint nrow = t->nrow();
+        if (nrow == 0) {
+            return true;
+        }
+        if (!col.isDefined(0)) {
+            return false;
+        }
+        IPosition shape = col.shape(0);
+        for (uint row = 1; row < nrow; ++row) {
+            if (!col.isDefined(row) || !col.shape(row).isEqual(shape)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void add_ragged_column_boolean(Table* t, char* name, int ndim) {
+        STATS_SCOPE();
+        addRaggedColumn<Bool>(t, name, ndim);
+    }
+    void add_ragged_column_int(Table* t, char* name, int ndim) {
+        STATS_SCOPE();
+        addRaggedColumn<Int>(t, name, ndim);
+    }
+    void add_ragged_column_float(Table* t, char* name, int ndim) {
+        STATS_SCOPE();
+        addRaggedColumn<Float>(t, name, ndim);
+    }
+    void add_ragged_column_double(Table* t, char* name, int ndim) {
+        STATS_SCOPE();
+        addRaggedColumn<Double>(t, name, ndim);
+    }
+    void add_ragged_column_complex(Table* t, char* name, int ndim) {
+        STATS_SCOPE();
+        addRaggedColumn<Complex>(t, name, ndim);
+    }
+    void add_ragged_column_string(Table* t, char* name, int ndim) {
+        STATS_SCOPE();
+        addRaggedColumn<String>(t, name, ndim);
+    }
+
+    bool* get_column_ragged_boolean(Table* t, char* name) {
+        STATS_SCOPE();
+        return getColumnRagged<Bool>(t, name);
+    }
+    int* get_column_ragged_int(Table* t, char* name) {
+        STATS_SCOPE();
+        return getColumnRagged<Int>(t, name);
+    }
+    float* get_column_ragged_float(Table* t, char* name) {
+        STATS_SCOPE();
+        return getColumnRagged<Float>(t, name);
+    }
+    double* get_column_ragged_double(Table* t, char* name) {
+        STATS_SCOPE();
+        return getColumnRagged<Double>(t, name);
+    }
+    cmplx* get_column_ragged_complex(Table* t, char* name) {
+        STATS_SCOPE();
+        return getColumnRagged<Complex>(t, name);
+    }
+    char** get_column_ragged_string(Table* t, char* name) {
+        STATS_SCOPE();
+        return getColumnRagged<String, char*>(t, name);
+    }
+
+    void put_column_ragged_boolean(Table* t, char* name, bool* input, int* shapes, int ndim) {
+        STATS_SCOPE();
+        putColumnRagged<Bool>(t, name, input, shapes, ndim);
+    }
+    void put_column_ragged_int(Table* t, char* name, int* input, int* shapes, int ndim) {
+        STATS_SCOPE();
+        putColumnRagged<Int>(t, name, input, shapes, ndim);
+    }
+    void put_column_ragged_float(Table* t, char* name, float* input, int* shapes, int ndim) {
+        STATS_SCOPE();
+        putColumnRagged<Float>(t, name, input, shapes, ndim);
+    }
+    void put_column_ragged_double(Table* t, char* name, double* input, int* shapes, int ndim) {
+        STATS_SCOPE();
+        putColumnRagged<Double>(t, name, input, shapes, ndim);
+    }
+    void put_column_ragged_complex(Table* t, char* name, cmplx* input, int* shapes, int ndim) {
+        STATS_SCOPE();
+        putColumnRagged<Complex>(t, name, input, shapes, ndim);
+    }
+    void put_column_ragged_string(Table* t, char* name, char** input, int* shapes, int ndim) {
+        STATS_SCOPE();
+        putColumnRagged<String, char*>(t, name, input, shapes, ndim);
+    }
+}
@@ -0,0 +1,250 @@
+// Copyright (c) 2015-2017 Michael Eastwood
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+#include "util.h"
+
+// Entire keyword sets (including nested records) can be transferred to and from Julia as a single
+// serialized buffer. This avoids making one call (and one copy of the keyword set) per keyword,
+// which adds up when reading all of the metadata of a measurement set and its subtables.
+//
+// The format of the buffer is:
+//
+//     record := nfields:int32 field*
+//     field  := name:string type:int32 value
+//     string := length:int32 bytes
+//     array  := ndim:int32 shape:int32[ndim] element*
+//
+// where `type` is the casacore::DataType of the field and the value depends on the type:
+//
+// * scalars are stored as their raw bytes (Bool is stored as a single byte)
+// * strings and arrays are stored as above (each element of a string array is a string)
+// * records are stored recursively
+// * tables are stored as the string "Table: <path>"
+//
+// Fields whose type has no Julia equivalent are stored with type TpOther and no value.
+//
+// All integers and values are stored in native byte order with no padding.
+
+class RecordWriter {
+    vector<char> buffer;
+
+public:
+    template <typename T>
+    void write(T const& value) {
+        char const* bytes = reinterpret_cast<char const*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void write_string(String const& string) {
+        write<int32_t>(string.size());
+        buffer.insert(buffer.end(), string.begin(), string.end());
+    }
+
+    void write_shape(IPosition const& shape) {
+        write<int32_t>(shape.size());
+        for (uint idx = 0; idx < shape.size(); ++idx) {
+            write<int32_t>(shape[idx]);
+        }
+    }
+
+    template <typename T>
+    void write_array(Array<T> const& array) {
+        write_shape(array.shape());
+        Bool delete_it;
+        T const* storage = array.getStorage(delete_it);
+        char const* bytes = reinterpret_cast<char const*>(storage);
+        buffer.insert(buffer.end(), bytes, bytes + array.nelements()*sizeof(T));
+        array.freeStorage(storage, delete_it);
+    }
+
+    void write_array(Array<String> const& array) {
+        write_shape(array.shape());
+        for (auto itr = array.begin(); itr != array.end(); ++itr) {
+            write_string(*itr);
+        }
+    }
+
+    void write_record(TableRecord const& record) {
+        uint N = record.nfields();
+        write<int32_t>(N);
+        for (uint idx = 0; idx < N; ++idx) {
+            RecordFieldId id(idx);
+            write_string(record.name(id));
+            write_field(record, id);
+        }
+    }
+
+    void write_field(TableRecord const& record, RecordFieldId const& id) {
+        DataType type = record.type(record.idToNumber(id));
+        switch (type) {
+            case TpBool:    write<int32_t>(type); write<Bool>(record.asBool(id)); break;
+            case TpInt:     write<int32_t>(type); write<Int>(record.asInt(id)); break;
+            case TpFloat:   write<int32_t>(type); write<Float>(record.asFloat(id)); break;
+            case TpDouble:  write<int32_t>(type); write<Double>(record.asDouble(id)); break;
+            case TpComplex: write<int32_t>(type); write<Complex>(record.asComplex(id)); break;
+            case TpString:  write<int32_t>(type); write_string(record.asString(id)); break;
+            case TpArrayBool:    write<int32_t>(type); write_array(record.asArrayBool(id)); break;
+            case TpArrayInt:     write<int32_t>(type); write_array(record.asArrayInt(id)); break;
+            case TpArrayFloat:   write<int32_t>(type); write_array(record.asArrayFloat(id)); break;
+            case TpArrayDouble:  write<int32_t>(type); write_array(record.asArrayDouble(id)); break;
+            case TpArrayComplex: write<int32_t>(type); write_array(record.asArrayComplex(id)); break;
+            case TpArrayString:  write<int32_t>(type); write_array(record.asArrayString(id)); break;
+            case TpRecord:
+                write<int32_t>(type);
+                write_record(record.subRecord(id));
+                break;
+            case TpTable:
+                // Use the table attributes so that we don't need to open the subtable.
+                write<int32_t>(type);
+                write_string("Table: " + record.tableAttributes(id).name());
+                break;
+            default:
+                write<int32_t>(TpOther);
+        }
+    }
+
+    char* output(size_t* length) {
+        StatsCopy stats;
+        *length = buffer.size();
+        char* output = new char[buffer.size()];
+        memcpy(output, buffer.data(), buffer.size());
+        stats.add(buffer.size(), 1);
+        return output;
+    }
+};
+
+class RecordReader {
+    char const* position;
+
+public:
+    explicit RecordReader(char const* buffer) : position(buffer) {}
+
+    template <typename T>
+    T read() {
+        T value;
+        memcpy(&value, position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+
+    String read_string() {
+        int32_t length = read<int32_t>();
+        String string(position, length);
+        position += length;
+        return string;
+    }
+
+    IPosition read_shape() {
+        int32_t ndim = read<int32_t>();
+        IPosition shape(ndim);
+        for (int idx = 0; idx < ndim; ++idx) {
+            shape[idx] = read<int32_t>();
+        }
+        return shape;
+    }
+
+    template <typename T>
+    Array<T> read_array() {
+        Array<T> array(read_shape());
+        size_t bytes = array.nelements()*sizeof(T);
+        // a newly constructed array is always contiguous
+        memcpy(array.data(), position, bytes);
+        position += bytes;
+        return array;
+    }
+
+    Array<String> read_string_array() {
+        Array<String> array(read_shape());
+        for (auto itr = array.begin(); itr != array.end(); ++itr) {
+            *itr = read_string();
+        }
+        return array;
+    }
+
+    void read_record(TableRecord& record) {
+        int32_t N = read<int32_t>();
+        for (int idx = 0; idx < N; ++idx) {
+            String name = read_string();
+            read_field(record, name);
+        }
+    }
+
+    void read_field(TableRecord& record, String const& name) {
+        int32_t type = read<int32_t>();
+        switch (type) {
+            case TpBool:    record.define(name, read<Bool>()); break;
+            case TpInt:     record.define(name, read<Int>()); break;
+            case TpFloat:   record.define(name, read<Float>()); break;
+            case TpDouble:  record.define(name, read<Double>()); break;
+            case TpComplex: record.define(name, read<Complex>()); break;
+            case TpString:  record.define(name, read_string()); break;
+            case TpArrayBool:    record.define(name, read_array<Bool>()); break;
+            case TpArrayInt:     record.define(name, read_array<Int>()); break;
+            case TpArrayFloat:   record.define(name, read_array<Float>()); break;
+            case TpArrayDouble:  record.define(name, read_array<Double>()); break;
+            case TpArrayComplex: record.define(name, read_array<Complex>()); break;
+            case TpArrayString:  record.define(name, read_string_array()); break;
+            case TpRecord: {
+                TableRecord subrecord;
+                read_record(subrecord);
+                record.defineRecord(name, subrecord);
+                break;
+            }
+            case TpTable: {
+                String path = read_string();
+                if (path.startsWith("Table: ")) {
+                    path = path.from(7);
+                }
+                record.defineTable(name, Table(path));
+                break;
+            }
+        }
+    }
+};
+
+extern "C" {
+    char* get_keyword_set(Table* t, size_t* length) {
+        STATS_SCOPE();
+        RecordWriter writer;
+        writer.write_record(t->keywordSet());
+        return writer.output(length);
+    }
+
+    char* get_column_keyword_set(Table* t, char* column, size_t* length) {
+        STATS_SCOPE();
+        TableColumn col(*t, column);
+        RecordWriter writer;
+        writer.write_record(col.keywordSet());
+        return writer.output(length);
+    }
+
+    void put_keyword_set(Table* t, char* buffer) {
+        STATS_SCOPE();
+        // Note that it is very important that `keywords` is a reference here. Otherwise we will
+        // make a copy of the `TableRecord` and any changes will fail to propagate back to the table.
+        TableRecord& keywords = t->rwKeywordSet();
+        RecordReader reader(buffer);
+        reader.read_record(keywords);
+    }
+
+    void put_column_keyword_set(Table* t, char* column, char* buffer) {
+        STATS_SCOPE();
+        TableColumn col(*t, column);
+        TableRecord& keywords = col.rwKeywordSet();
+        RecordReader reader(buffer);
+        reader.read_record(keywords);
+    }
+}
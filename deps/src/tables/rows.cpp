@@ -17,14 +17,17 @@
 
 extern "C" {
     uint num_rows(Table* t) {
+        STATS_SCOPE();
         return t->nrow();
     }
 
     void add_rows(Table* t, uint number) {
+        STATS_SCOPE();
         t->addRow(number, true); // always initialize the new rows
     }
 
     void remove_rows(Table* t, uint* row_numbers, size_t length) {
+        STATS_SCOPE();
         auto my_row_numbers = input_vector(row_numbers, length);
         t->removeRow(*my_row_numbers);
     }
@@ -14,6 +14,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "util.h"
+#include <casacore/tables/Tables/TableCopy.h>
 
 // Tables can store data in a variety of places:
 //
@@ -46,18 +47,168 @@
 
 // All the functions defined within `extern "C" { ... }` may be called directly from Julia.
 
+// Columns can only be concatenated if their cells are interchangeable. In particular a fixed shape
+// column takes the shape of its first part, so every part must have the same shape (per-subband
+// measurement sets with different numbers of channels can't be concatenated).
+static bool same_column(ColumnDesc const& lhs, ColumnDesc const& rhs) {
+    if (lhs.dataType() != rhs.dataType() || lhs.isScalar() != rhs.isScalar()) {
+        return false;
+    }
+    if (lhs.isScalar()) {
+        return true;
+    }
+    if (lhs.isFixedShape() != rhs.isFixedShape() || lhs.ndim() != rhs.ndim()) {
+        return false;
+    }
+    return !lhs.isFixedShape() || lhs.shape().isEqual(rhs.shape());
+}
+
 extern "C" {
     Table* new_table_open(char* path, int mode) {
+        STATS_SCOPE();
         return new Table(path, Table::TableOption(mode));
     }
+    Table* new_table_open_with_lock(char* path, int mode, int lock_option, double interval) {
+        STATS_SCOPE();
+        // `lock_option` must mirror the ordering of `TableLock::LockOption`, and `interval` is the
+        // inspection interval (in seconds) used by AutoLocking.
+        TableLock lock(TableLock::LockOption(lock_option), interval);
+        return new Table(path, lock, Table::TableOption(mode));
+    }
     Table* new_table_create(char* path) {
+        STATS_SCOPE();
         SetupNewTable maker(path, TableDesc(), Table::NewNoReplace);
         return new Table(maker, 0); // 0 rows by default
     }
     void delete_table(Table* t) {delete t;}
 
+    // Every column is copied if `ncolumns` is zero. Every row is copied unless `select_rows` is
+    // set, in which case only the `nrows` given rows are copied (possibly none at all).
+    Table* new_table_copy(Table* t, char* path, char** columns, int ncolumns,
+                          uint* rows, size_t nrows, bool select_rows, bool replace_tiled) {
+        STATS_SCOPE();
+        if (ncolumns == 0 && !select_rows && !replace_tiled && t->isRootTable()) {
+            // Nothing needs to change so we can simply copy the files that make up the table. This
+            // moves the column data in large blocks and is much faster than copying row by row.
+            t->copy(path, Table::New);
+            return new Table(path, Table::Update);
+        }
+        // Otherwise build a reference table that selects the requested columns and rows, and then
+        // write out a new table containing only that subset of the data.
+        Table selection = *t;
+        if (ncolumns > 0) {
+            Block<String> names(ncolumns);
+            for (int idx = 0; idx < ncolumns; ++idx) {
+                names[idx] = String(columns[idx]);
+            }
+            selection = selection.project(names);
+        }
+        if (select_rows) {
+            auto rownrs = input_vector(rows, nrows);
+            selection = selection(*rownrs);
+        }
+        if (replace_tiled) {
+            // Replace the tiled storage managers with the standard storage manager. Note that this
+            // does not choose new tile shapes, the data is simply no longer tiled.
+            Table output = TableCopy::makeEmptyTable(path, Record(), selection, Table::New,
+                                                     Table::AipsrcEndian, true, true);
+            TableCopy::copyInfo(output, selection);
+            TableCopy::copyRows(output, selection);
+            TableCopy::copySubTables(output, selection);
+            return new Table(output);
+        }
+        else {
+            selection.deepCopy(path, Table::New, true);
+            return new Table(path, Table::Update);
+        }
+    }
+
+    Table* new_table_concat(Table** tables, int ntables, char** subtables, int nsubtables) {
+        STATS_SCOPE();
+        // The tables must all have the same columns (with the same data types) or casacore will
+        // throw an exception that we cannot recover from, so check this first and return a null
+        // pointer if they don't match.
+        auto description = tables[0]->tableDesc();
+        auto names = description.columnNames();
+        for (int idx = 1; idx < ntables; ++idx) {
+            auto other = tables[idx]->tableDesc();
+            if (other.ncolumn() != description.ncolumn()) {
+                return nullptr;
+            }
+            for (uint jdx = 0; jdx < names.size(); ++jdx) {
+                if (!other.isColumn(names[jdx]) ||
+                        !same_column(other.columnDesc(names[jdx]),
+                                     description.columnDesc(names[jdx]))) {
+                    return nullptr;
+                }
+            }
+        }
+        // casacore::Table is reference counted so the concatenation keeps the original tables
+        // alive even after they are closed on the Julia side.
+        Block<Table> blocks(ntables);
+        for (int idx = 0; idx < ntables; ++idx) {
+            blocks[idx] = *tables[idx];
+        }
+        Block<String> subtable_names(nsubtables);
+        for (int idx = 0; idx < nsubtables; ++idx) {
+            subtable_names[idx] = String(subtables[idx]);
+        }
+        try {
+            return new Table(blocks, subtable_names);
+        }
+        catch (AipsError&) {
+            // for example one of the subtables is missing from one of the tables
+            return nullptr;
+        }
+    }
+
+    // Returns a reference table with the rows sorted on the given (scalar) columns. The first
+    // column is the primary sort key, the second column is the secondary sort key, and so on. If
+    // `unique` is true, only the first row with each distinct combination of keys is kept. The sort
+    // is stable so rows with equal keys stay in their original order.
+    Table* new_table_sort(Table* t, char** columns, bool* descending, int ncolumns, bool unique) {
+        STATS_SCOPE();
+        Block<String> names(ncolumns);
+        Block<Int> orders(ncolumns);
+        for (int idx = 0; idx < ncolumns; ++idx) {
+            names[idx] = String(columns[idx]);
+            orders[idx] = descending[idx] ? Sort::Descending : Sort::Ascending;
+        }
+        int option = Sort::ParSort; // a (stable) merge sort
+        if (unique) {
+            option |= Sort::NoDuplicates;
+        }
+        return new Table(t->sort(names, orders, option));
+    }
+
     char* table_name(Table* t) {
+        STATS_SCOPE();
         return output_string(t->tableName());
     }
+
+    // Explicit locking is only needed when the table was opened with UserLocking (or when the
+    // user wants to hold onto an AutoLocking lock for longer than usual).
+
+    bool lock_table(Table* t, bool write, int attempts) {
+        STATS_SCOPE();
+        auto type = write ? FileLocker::Write : FileLocker::Read;
+        return t->lock(type, attempts);
+    }
+    void unlock_table(Table* t) {
+        STATS_SCOPE();
+        t->unlock();
+    }
+    bool table_has_lock(Table* t, bool write) {
+        STATS_SCOPE();
+        auto type = write ? FileLocker::Write : FileLocker::Read;
+        return t->hasLock(type);
+    }
+
+    // Changes are otherwise only guaranteed to reach the disk when the table is closed.
+
+    void flush_table(Table* t, bool fsync, bool recursive) {
+        STATS_SCOPE();
+        t->flush(fsync, recursive);
+    }
 }
 
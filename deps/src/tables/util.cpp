@@ -28,13 +28,16 @@ IPosition create_shape(int const* dims, int ndim) {
 }
 
 char* output_string(String const& string) {
+    StatsCopy stats;
     int N = string.length(); // length doesn't count null termination
+    stats.add(N+1, 1);
     char* output = new char[N+1];
     strcpy(output, string.c_str());
     return output;
 }
 
 char** output_array(Array<String> const& array) {
+    StatsCopy stats;
     auto shape = array.shape();
     int length = shape.product();
     char** output = new char*[length];
@@ -42,31 +45,39 @@ char** output_array(Array<String> const& array) {
     int idx = 0;
     while (itr != array.end()) {
         output[idx] = output_string(*itr);
+        stats.add(itr->length()+1, 1);
         ++itr; ++idx;
     }
+    stats.add(length*sizeof(char*), 1);
     return output;
 }
 
 unique_ptr<Vector<String> > input_vector(char* const* input, int length) {
+    StatsCopy stats;
     auto vec = unique_ptr<Vector<String> >(new Vector<String>(length));
     auto itr = vec->begin();
     int idx = 0;
     while (itr != vec->end()) {
         *itr = String(input[idx]);
+        stats.add(itr->length()+1, 1);
         ++itr; ++idx;
     }
+    stats.add(0, 1);
     return vec;
 }
 
 unique_ptr<Array<String> > input_array(char* const* input, int const* dims, int ndim) {
+    StatsCopy stats;
     auto shape = create_shape(dims, ndim);
     auto arr = unique_ptr<Array<String> >(new Array<String>(shape));
     auto itr = arr->begin();
     int idx = 0;
     while (itr != arr->end()) {
         *itr = String(input[idx]);
+        stats.add(itr->length()+1, 1);
         ++itr; ++idx;
     }
+    stats.add(0, 1);
     return arr;
 }
 
@@ -24,6 +24,8 @@ using namespace std;
 #include <casacore/tables/Tables.h>
 using namespace casacore;
 
+#include "../stats/stats.h"
+
 typedef complex<float> cmplx;
 
 // Define a host of helpful methods that convert between casacore::Array and standard C arrays.
@@ -39,9 +41,11 @@ char* output_string(String const& string);
 
 template <typename T>
 T* output_array(Array<T> const& array) {
+    StatsCopy stats;
     auto shape = array.shape();
     int length = shape.product();
     T* output = new T[length];
+    stats.add(length*sizeof(T), 1);
     if (array.contiguousStorage()) {
         // If the array is contiguous we can use memcpy for maximum speed here.
         T const* raw = array.data();
@@ -59,6 +63,8 @@ char** output_array(Array<String> const& array);
 
 template <typename T>
 unique_ptr<Vector<T> > input_vector(T const* input, int length) {
+    StatsCopy stats;
+    stats.add(length*sizeof(T), 1);
     auto shape = create_shape(length);
     return unique_ptr<Vector<T> >(new Vector<T>(shape, input));
 }
@@ -67,7 +73,9 @@ unique_ptr<Vector<String> > input_vector(char* const* input, int length);
 
 template <typename T>
 unique_ptr<Array<T> > input_array(T const* input, int const* dims, int ndim) {
+    StatsCopy stats;
     auto shape = create_shape(dims, ndim);
+    stats.add(shape.product()*sizeof(T), 1);
     return unique_ptr<Array<T> >(new Array<T>(shape, input));
 }
 
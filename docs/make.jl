@@ -8,7 +8,8 @@ makedocs(
         "Introduction" => "index.md",
         "Modules" => [
             "CasaCore.Tables" => "tables.md",
-            "CasaCore.Measures" => "measures.md"
+            "CasaCore.Measures" => "measures.md",
+            "CasaCore.MeasurementSets" => "measurement-sets.md"
         ]
     ]
 )
@@ -20,6 +20,7 @@ module CasaCore
 include("Tables.jl")
 include("Measures.jl")
 include("MeasurementSets.jl")
+include("stats.jl")
 
 end
 
@@ -17,6 +17,7 @@
 module MeasurementSets
 
 using ..Tables
+using ..Measures
 
 const libcasacorewrapper = normpath(joinpath(@__DIR__, "..", "deps", "src",
                                              "libcasacorewrapper.so"))
@@ -26,6 +27,8 @@ function __init__()
 end
 
 include("measurement-sets/measurement-sets.jl")
+include("measurement-sets/cube.jl")
+include("measurement-sets/rephase.jl")
 
 end
 
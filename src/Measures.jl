@@ -19,10 +19,11 @@ module Measures
 export CasaCoreMeasuresError
 
 export Epoch, Direction, Position, Baseline
+export DirectionBatch, PositionBatch, BaselineBatch
 export @epoch_str, @dir_str, @pos_str, @baseline_str
 
-export ReferenceFrame
-export set!, measure
+export ReferenceFrame, FastConverter
+export set!, measure, measure!
 
 export longitude, latitude, observatory, sexagesimal
 export angle_between, gram_schmidt
@@ -57,6 +58,9 @@ include("measures/baselines.jl")
 include("measures/conversions.jl")
 include("measures/mathematics.jl")
 include("measures/rotations.jl")
+include("measures/batches.jl")
+include("measures/interpolation.jl")
+include("measures/warmup.jl")
 
 end
 
@@ -0,0 +1,193 @@
+# Copyright (c) 2015-2017 Michael Eastwood
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+@noinline function cube_size_error(expected, actual)
+    Tables.err("expected a cube of size $expected but got one of size $actual")
+end
+
+@noinline function cube_flags_error(flags)
+    Tables.err("unknown flag option $flags (expected :nan, :mask, or :ignore)")
+end
+
+const cube_flag_modes = Dict(:ignore => Cint(0), :nan => Cint(1), :mask => Cint(2))
+
+# data descriptions are 1-based (as in `MeasurementSets.Metadata`) and -1 selects every row
+cube_ddid(data_description) = data_description === nothing ? Cint(-1) : Cint(data_description-1)
+
+function cube_rows(ms::Table, rows)
+    N = Tables.num_rows(ms)
+    rows === nothing && return 0, N
+    rows = convert(UnitRange{Int}, rows)
+    if !isempty(rows) && (first(rows) ≤ 0 || last(rows) ≥ N+1)
+        Tables.row_out_of_bounds_error(rows)
+    end
+    first(rows)-1, first(rows)-1+length(rows)
+end
+
+"""
+    MeasurementSets.visibility_cube_size(ms; column="DATA", rows=nothing,
+                                         data_description=nothing, flags=:ignore)
+
+Returns the size `(Npol, Nchan, Nbase, Ntime)` of the cube that will be filled by
+[`MeasurementSets.visibility_cube!`](@ref).
+
+**Arguments:**
+
+- `ms` - the measurement set
+
+**Keyword Arguments:**
+
+- `column` - the column containing the visibilities
+- `rows` - a range of rows to use (all of the rows are used by default)
+- `data_description` - only use the rows with this (1-based) data description
+- `flags` - unless this is `:ignore`, also check that the `FLAG` and `FLAG_ROW` columns exist and
+  that the cells of `FLAG` have the same shape as the visibilities (see
+  [`MeasurementSets.visibility_cube!`](@ref))
+"""
+function visibility_cube_size(ms::Table; column::String="DATA", rows=nothing,
+                              data_description=nothing, flags::Symbol=:ignore)
+    Tables.isopen(ms) || Tables.table_closed_error()
+    haskey(cube_flag_modes, flags) || cube_flags_error(flags)
+    names = flags == :ignore ? (column, "TIME", "ANTENNA1", "ANTENNA2") :
+                               (column, "TIME", "ANTENNA1", "ANTENNA2", "FLAG", "FLAG_ROW")
+    for name in names
+        Tables.column_exists(ms, name) || Tables.column_missing_error(name)
+    end
+    start, stop = cube_rows(ms, rows)
+    dims = zeros(Cint, 4)
+    message = ccall((:visibility_cube_size, libcasacorewrapper), Ptr{Cchar},
+                    (Ptr{Tables.CasaCoreTable}, Ptr{Cchar}, Cuint, Cuint, Cint, Cint, Ptr{Cint}),
+                    ms, column, start, stop, cube_ddid(data_description), cube_flag_modes[flags],
+                    dims)
+    message == C_NULL || Tables.err(Tables.wrap_value(message))
+    tuple(Int.(dims)...)
+end
+
+"""
+    MeasurementSets.visibility_cube!(cube, ms; column="DATA", rows=nothing,
+                                     data_description=nothing, flags=:nan, mask=nothing,
+                                     threads=1)
+
+Fill a dense `(Npol, Nchan, Nbase, Ntime)` cube with the visibilities of the measurement set. The
+size of the cube is given by [`MeasurementSets.visibility_cube_size`](@ref).
+
+Baselines are ordered (1,1), (1,2), ..., (1,N), (2,2), ..., (N,N), where the antennas are numbered
+by their row in the ANTENNA subtable. A row with `ANTENNA1 > ANTENNA2` is conjugated (and has its
+cross-hand polarizations swapped) to fit this ordering. The times are the sorted unique values of
+the `TIME` column.
+
+A cube holds a single data description (spectral window), so if the rows have more than one
+data description, one must be selected with `data_description`. It is also an error for two of the
+selected rows to have the same time and baseline (for example if the measurement set contains more
+than one field).
+
+Returns the times and the number of rows that were skipped because they refer to an antenna that
+is not in the ANTENNA subtable.
+
+**Arguments:**
+
+- `cube` - the cube to fill
+- `ms` - the measurement set
+
+**Keyword Arguments:**
+
+- `column` - the column containing the visibilities
+- `rows` - a range of rows to use (all of the rows are used by default)
+- `data_description` - only use the rows with this (1-based) data description
+- `flags` - how the `FLAG` and `FLAG_ROW` columns are applied: `:nan` replaces flagged
+  visibilities with NaN, `:mask` writes the flags to `mask`, and `:ignore` skips the flags (in
+  which case the `FLAG` and `FLAG_ROW` columns are not needed)
+- `mask` - a boolean array with the same size as `cube` (required when `flags=:mask`)
+- `threads` - the number of threads used to copy the visibilities into the cube
+
+Elements of the cube that do not correspond to any row are treated as flagged (or set to zero if
+the flags are ignored).
+
+**See also:** [`MeasurementSets.visibility_cube`](@ref)
+"""
+function visibility_cube!(cube::Array{Complex64, 4}, ms::Table; column::String="DATA",
+                          rows=nothing, data_description=nothing, flags::Symbol=:nan,
+                          mask=nothing, threads::Integer=1)
+    haskey(cube_flag_modes, flags) || cube_flags_error(flags)
+    expected = visibility_cube_size(ms, column=column, rows=rows,
+                                    data_description=data_description, flags=flags)
+    size(cube) == expected || cube_size_error(expected, size(cube))
+    if flags == :mask
+        mask isa Array{Bool, 4} || Tables.err("a boolean mask is required when flags=:mask")
+        size(mask) == expected || cube_size_error(expected, size(mask))
+        c_mask = mask
+    else
+        c_mask = C_NULL
+    end
+    start, stop = cube_rows(ms, rows)
+    times = zeros(Float64, expected[4])
+    skipped = Ref{Csize_t}(0)
+    message = ccall((:fill_visibility_cube, libcasacorewrapper), Ptr{Cchar},
+                    (Ptr{Tables.CasaCoreTable}, Ptr{Cchar}, Cuint, Cuint, Cint, Ptr{Complex64},
+                     Ptr{Bool}, Ptr{Cint}, Cint, Ptr{Float64}, Cint, Ref{Csize_t}),
+                    ms, column, start, stop, cube_ddid(data_description), cube, c_mask,
+                    Cint[expected...], cube_flag_modes[flags], times, max(threads, 1), skipped)
+    message == C_NULL || Tables.err(Tables.wrap_value(message))
+    times, Int(skipped[])
+end
+
+"""
+    struct VisibilityCube
+
+The visibilities of a measurement set arranged as a dense cube. Obtain this with
+[`MeasurementSets.visibility_cube`](@ref).
+
+**Fields:**
+
+- `data` - the `(Npol, Nchan, Nbase, Ntime)` cube of visibilities
+- `mask` - the flags (with the same size as `data`) if the cube was read with `flags=:mask`,
+  otherwise an empty array
+- `times` - the time of each integration (in seconds)
+- `skipped` - the number of rows that were skipped because they refer to an unknown antenna
+"""
+struct VisibilityCube
+    data    :: Array{Complex64, 4}
+    mask    :: Array{Bool, 4}
+    times   :: Vector{Float64}
+    skipped :: Int
+end
+
+"""
+    MeasurementSets.visibility_cube(ms; column="DATA", rows=nothing, data_description=nothing,
+                                    flags=:nan, threads=1)
+
+Read the visibilities of the measurement set into a dense `(Npol, Nchan, Nbase, Ntime)` cube and
+return a [`MeasurementSets.VisibilityCube`](@ref). See
+[`MeasurementSets.visibility_cube!`](@ref) for a description of the arguments.
+
+**Usage:**
+
+```julia
+ms = Tables.open("/data/observation.ms")
+cube = MeasurementSets.visibility_cube(ms, column="CORRECTED_DATA", flags=:mask)
+```
+"""
+function visibility_cube(ms::Table; column::String="DATA", rows=nothing,
+                         data_description=nothing, flags::Symbol=:nan, threads::Integer=1)
+    haskey(cube_flag_modes, flags) || cube_flags_error(flags)
+    dims = visibility_cube_size(ms, column=column, rows=rows, data_description=data_description,
+                                flags=flags)
+    data = Array{Complex64}(dims)
+    mask = flags == :mask ? Array{Bool}(dims) : Array{Bool}(0, 0, 0, 0)
+    times, skipped = visibility_cube!(data, ms, column=column, rows=rows,
+                                      data_description=data_description, flags=flags,
+                                      mask=flags == :mask ? mask : nothing, threads=threads)
+    VisibilityCube(data, mask, times, skipped)
+end
@@ -13,6 +13,27 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+"""
+    MeasurementSets.create(path)
+
+Create a measurement set at the given path with all of the required columns and (empty) subtables.
+
+**Arguments:**
+
+- `path` - the path where the measurement set will be created
+
+**Usage:**
+
+```jldoctest
+julia> ms = MeasurementSets.create("/tmp/my-measurement-set.ms")
+       Tables.column_exists(ms, "UVW")
+true
+
+julia> Tables.delete(ms)
+```
+
+**See also:** [`MeasurementSets.metadata`](@ref), [`Tables.create`](@ref)
+"""
 function create(path)
     path = Tables.table_fix_path(path)
     if isfile(path) || isdir(path)
@@ -23,3 +44,191 @@ function create(path)
     Table(path, Tables.readwrite, ptr)
 end
 
+
+@noinline function not_a_measurement_set_error(subtable)
+    Tables.err("the measurement set is missing the $subtable subtable")
+end
+
+"""
+    struct Metadata
+
+The contents of the standard subtables of a measurement set that are needed by nearly every
+consumer of the visibilities. Obtain this with [`MeasurementSets.metadata`](@ref).
+
+**Fields:**
+
+- `antenna_names` - the name of each antenna
+- `antenna_positions` - the ITRF position of each antenna in meters (`3 × Nant`)
+- `channel_frequencies` - the frequency of each channel in Hz (one vector per spectral window)
+- `field_names` - the name of each field
+- `field_directions` - the phase center of each field in radians (`2 × Nfield`) in the reference
+  frame of the `PHASE_DIR` column (usually J2000)
+- `data_description_spw` - the spectral window of each data description
+- `data_description_polarization` - the polarization setup of each data description
+- `correlation_types` - the Stokes type of each correlation (one vector per polarization setup)
+
+!!! note
+    Unlike the columns of the measurement set, the indices in `data_description_spw` and
+    `data_description_polarization` are 1-based so that they can be used to directly index
+    `channel_frequencies` and `correlation_types`.
+"""
+struct Metadata
+    antenna_names :: Vector{String}
+    antenna_positions :: Matrix{Float64}
+    channel_frequencies :: Vector{Vector{Float64}}
+    field_names :: Vector{String}
+    field_directions :: Matrix{Float64}
+    data_description_spw :: Vector{Int}
+    data_description_polarization :: Vector{Int}
+    correlation_types :: Vector{Vector{Int32}}
+end
+
+struct CasaCoreMetadata end
+
+mutable struct MetadataHandle
+    ptr :: Ptr{CasaCoreMetadata}
+    function MetadataHandle(ptr)
+        handle = new(ptr)
+        finalizer(handle, handle -> ccall((:delete_measurement_set_metadata, libcasacorewrapper),
+                                          Void, (Ptr{CasaCoreMetadata},), handle.ptr))
+        handle
+    end
+end
+
+Base.unsafe_convert(::Type{Ptr{CasaCoreMetadata}}, handle::MetadataHandle) = handle.ptr
+
+const metadata_subtables = (kw"ANTENNA", kw"SPECTRAL_WINDOW", kw"FIELD",
+                            kw"DATA_DESCRIPTION", kw"POLARIZATION")
+
+# The metadata is cached along with the paths of the subtables it was read from and the number of
+# writes made to each of them through this process at the time (see `Tables.written!`).
+const metadata_cache = WeakKeyDict{Table, Tuple{MetadataHandle, Metadata, Vector{String},
+                                                Vector{Int}}}()
+
+modification_counts(paths) = [Tables.modification_count(path) for path in paths]
+
+function split_ragged(data, lengths)
+    offsets = cumsum([0; lengths])
+    [data[offsets[idx]+1:offsets[idx+1]] for idx = 1:length(lengths)]
+end
+
+function load_metadata(ms::Table)
+    paths = String[]
+    for subtable in metadata_subtables
+        Tables.keyword_exists(ms, subtable) || not_a_measurement_set_error(subtable)
+        table = ms[subtable]
+        push!(paths, table.path)
+        Tables.close(table)
+    end
+    counts = modification_counts(paths)
+    ptr = Ref{Ptr{CasaCoreMetadata}}(C_NULL)
+    message = ccall((:new_measurement_set_metadata, libcasacorewrapper), Ptr{Cchar},
+                    (Ptr{Tables.CasaCoreTable}, Ref{Ptr{CasaCoreMetadata}}), ms, ptr)
+    message == C_NULL || Tables.err(Tables.wrap_value(message))
+    handle = MetadataHandle(ptr[])
+
+    sizes = zeros(Cint, 7)
+    ccall((:measurement_set_metadata_sizes, libcasacorewrapper), Void,
+          (Ptr{CasaCoreMetadata}, Ptr{Cint}), handle, sizes)
+    Nant, Nspw, Nchan, Nfield, Nddid, Npol, Ncorr = sizes
+    antenna_positions = zeros(Float64, 3, Nant)
+    num_channels = zeros(Cint, Nspw)
+    channel_frequencies = zeros(Float64, Nchan)
+    field_directions = zeros(Float64, 2, Nfield)
+    data_description_spw = zeros(Cint, Nddid)
+    data_description_polarization = zeros(Cint, Nddid)
+    num_correlations = zeros(Cint, Npol)
+    correlation_types = zeros(Cint, Ncorr)
+    ccall((:measurement_set_metadata_copy, libcasacorewrapper), Void,
+          (Ptr{CasaCoreMetadata}, Ptr{Float64}, Ptr{Cint}, Ptr{Float64}, Ptr{Float64},
+           Ptr{Cint}, Ptr{Cint}, Ptr{Cint}, Ptr{Cint}),
+          handle, antenna_positions, num_channels, channel_frequencies, field_directions,
+          data_description_spw, data_description_polarization, num_correlations,
+          correlation_types)
+    antenna_names = ccall((:measurement_set_metadata_antenna_names, libcasacorewrapper),
+                          Ptr{Ptr{Cchar}}, (Ptr{CasaCoreMetadata},), handle)
+    field_names = ccall((:measurement_set_metadata_field_names, libcasacorewrapper),
+                        Ptr{Ptr{Cchar}}, (Ptr{CasaCoreMetadata},), handle)
+
+    metadata = Metadata(Tables.wrap(antenna_names, (Nant,)), antenna_positions,
+                        split_ragged(channel_frequencies, num_channels),
+                        Tables.wrap(field_names, (Nfield,)), field_directions,
+                        data_description_spw .+ 1, data_description_polarization .+ 1,
+                        split_ragged(correlation_types, num_correlations))
+    handle, metadata, paths, counts
+end
+
+"""
+    MeasurementSets.metadata(ms)
+
+Load the antenna positions, channel frequencies, field directions, and data description mapping
+of the measurement set.
+
+The subtables are only read the first time this function is called. Subsequent calls return the
+same (immutable) [`MeasurementSets.Metadata`](@ref) unless one of the subtables has been modified
+since, in which case the metadata is reloaded. An error is thrown if a cell of one of the subtables
+is undefined (for example a spectral window without `CHAN_FREQ`).
+
+!!! note
+    Changes made to the subtables through this package (in this process) are always detected.
+    Changes made by other processes are detected through the modification time of the subtables,
+    which has a resolution of one second. They are therefore only seen once they have been flushed
+    to disk and at least a second has passed since the metadata was loaded, and a change flushed
+    within the same second as the metadata was loaded can be missed altogether (unless it adds or
+    removes rows). The modification time is not checked at all for a measurement set opened with
+    `Tables.NoLocking`. Use [`MeasurementSets.invalidate_metadata!`](@ref) whenever it is known
+    that another process has changed the subtables.
+
+**Arguments:**
+
+- `ms` - the measurement set
+
+**Usage:**
+
+```jldoctest
+julia> ms = MeasurementSets.create("/tmp/my-measurement-set.ms")
+       metadata = MeasurementSets.metadata(ms)
+       length(metadata.antenna_names)
+0
+
+julia> Tables.delete(ms)
+```
+
+**See also:** [`MeasurementSets.invalidate_metadata!`](@ref)
+"""
+function metadata(ms::Table)
+    Tables.isopen(ms) || Tables.table_closed_error()
+    if haskey(metadata_cache, ms)
+        handle, metadata, paths, counts = metadata_cache[ms]
+        # always call into casacore so that its change flags stay up to date
+        changed = ccall((:measurement_set_metadata_changed, libcasacorewrapper), Bool,
+                        (Ptr{CasaCoreMetadata},), handle)
+        changed = changed || modification_counts(paths) != counts
+        changed || return metadata
+        # the change flags have now been reset, so don't leave stale metadata behind if the
+        # subtables can no longer be read
+        delete!(metadata_cache, ms)
+    end
+    cached = load_metadata(ms)
+    metadata_cache[ms] = cached
+    cached[2]
+end
+
+"""
+    MeasurementSets.invalidate_metadata!(ms)
+
+Discard the cached metadata of the measurement set so that the next call to
+[`MeasurementSets.metadata`](@ref) rereads the subtables.
+
+Changes made to the subtables through this package are detected automatically, so this is only
+needed when another process has modified the subtables (see [`MeasurementSets.metadata`](@ref)), or
+when they have been modified directly through casacore.
+
+**Arguments:**
+
+- `ms` - the measurement set
+"""
+function invalidate_metadata!(ms::Table)
+    delete!(metadata_cache, ms)
+    ms
+end
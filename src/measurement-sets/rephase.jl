@@ -0,0 +1,67 @@
+# Copyright (c) 2015-2017 Michael Eastwood
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+    MeasurementSets.rephase!(ms, direction; columns=["DATA"])
+
+Move the phase center of every row of the measurement set to the given direction. The `UVW` column
+is rotated to the new phase center, each of the given columns is multiplied by the corresponding
+phase factor `exp(-2πi Δw ν / c)`, and the `PHASE_DIR` of every field is set to the new phase
+center. The measurement set is modified in place, one chunk of rows at a time.
+
+Every row is checked before the measurement set is modified, so if an error is thrown (for example
+because a row refers to a field or data description that does not exist) the measurement set is
+left untouched.
+
+The direction may be given in any coordinate system. If it moves with respect to the coordinate
+system of the `PHASE_DIR` column (for example the Sun, or a fixed azimuth and elevation), the
+direction is tracked using the time of each row and the center of the array.
+
+**Arguments:**
+
+- `ms` - the measurement set (which must be open for writing)
+- `direction` - the new phase center
+
+**Keyword Arguments:**
+
+- `columns` - the visibility columns to rotate (for example `["DATA", "MODEL_DATA",
+  "CORRECTED_DATA"]`)
+
+**Usage:**
+
+```julia
+ms = Tables.open("/data/observation.ms", write=true)
+MeasurementSets.rephase!(ms, Direction(dir"J2000", "19h59m28.4s", "+40d44m02s"),
+                         columns=["DATA", "CORRECTED_DATA"])
+```
+"""
+function rephase!(ms::Table, direction::Direction; columns=["DATA"])
+    Tables.isopen(ms) || Tables.table_closed_error()
+    Tables.iswritable(ms) || Tables.table_readonly_error()
+    for subtable in (kw"ANTENNA", kw"SPECTRAL_WINDOW", kw"FIELD", kw"DATA_DESCRIPTION",
+                     kw"POLARIZATION")
+        Tables.keyword_exists(ms, subtable) || not_a_measurement_set_error(subtable)
+    end
+    c_columns = collect(String, columns)
+    for column in ("TIME", "FIELD_ID", "DATA_DESC_ID", "UVW", c_columns...)
+        Tables.column_exists(ms, column) || Tables.column_missing_error(column)
+    end
+    message = ccall((:rephase_measurement_set, libcasacorewrapper), Ptr{Cchar},
+                    (Ptr{Tables.CasaCoreTable}, Ref{Direction}, Ptr{Ptr{Cchar}}, Cint),
+                    ms, direction, c_columns, length(c_columns))
+    message == C_NULL || Tables.err(Tables.wrap_value(message))
+    invalidate_metadata!(ms)
+    ms
+end
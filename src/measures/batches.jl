@@ -0,0 +1,274 @@
+# Copyright (c) 2015-2017 Michael Eastwood
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+    MeasureBatch{T} <: AbstractVector{T}
+
+A batch of directions, positions, or baselines that all share the same coordinate system. The
+coordinates are stored as a structure of arrays (separate `x`, `y`, and `z` vectors), which allows a
+whole batch to be converted to a new coordinate system with a single call to CasaCore.
+
+Use the aliases `DirectionBatch`, `PositionBatch`, and `BaselineBatch` to construct a batch.
+Indexing a batch returns the individual `Direction`, `Position`, or `Baseline`.
+
+**Examples:**
+
+``` julia
+using Unitful: m, °
+directions = DirectionBatch(dir"J2000", [0°, 90°, 180°], [0°, 45°, 90°])
+directions = DirectionBatch([Direction(dir"J2000"), Direction(dir"J2000", 1, 2, 3)])
+positions  = PositionBatch(pos"ITRF", randn(10), randn(10), randn(10))
+azel = measure(frame, directions, dir"AZEL")
+```
+"""
+struct MeasureBatch{T<:VectorMeasure, S} <: AbstractVector{T}
+    sys :: S
+    x :: Vector{Float64}
+    y :: Vector{Float64}
+    z :: Vector{Float64}
+    function MeasureBatch{T, S}(sys, x, y, z) where {T, S}
+        if !(length(x) == length(y) == length(z))
+            throw(DimensionMismatch("the x, y, and z coordinates must have the same length"))
+        end
+        if T == Direction
+            # directions are always normalized
+            magnitude = hypot.(x, y, z)
+            x = x ./ magnitude
+            y = y ./ magnitude
+            z = z ./ magnitude
+        end
+        new(sys, x, y, z)
+    end
+end
+
+const DirectionBatch = MeasureBatch{Direction, Directions.System}
+const PositionBatch  = MeasureBatch{Position,  Positions.System}
+const BaselineBatch  = MeasureBatch{Baseline,  Baselines.System}
+
+function (::Type{MeasureBatch{T, S}})(measures::AbstractVector) where {T, S}
+    isempty(measures) && err("cannot infer the coordinate system of an empty batch")
+    sys = first(measures).sys
+    for measure in measures
+        measure.sys == sys || inconsistent_coordinate_system_error()
+    end
+    x = Float64[measure.x for measure in measures]
+    y = Float64[measure.y for measure in measures]
+    z = Float64[measure.z for measure in measures]
+    MeasureBatch{T, S}(sys, x, y, z)
+end
+
+function (::Type{DirectionBatch})(sys::Directions.System,
+                                  longitude::AbstractVector{<:Angle},
+                                  latitude::AbstractVector{<:Angle})
+    long = ustrip.(uconvert.(u"rad", longitude))
+    lat  = ustrip.(uconvert.(u"rad",  latitude))
+    DirectionBatch(sys, cos.(lat).*cos.(long), cos.(lat).*sin.(long), sin.(lat))
+end
+
+function (::Type{DirectionBatch})(sys::Directions.System,
+                                  longitude::AbstractVector{<:AbstractString},
+                                  latitude::AbstractVector{<:AbstractString})
+    DirectionBatch(sys, sexagesimal(longitude)*u"rad", sexagesimal(latitude)*u"rad")
+end
+
+Base.size(batch::MeasureBatch) = size(batch.x)
+Base.IndexStyle(::Type{<:MeasureBatch}) = IndexLinear()
+
+function Base.getindex(batch::MeasureBatch{T}, idx::Int) where T
+    T(batch.sys, batch.x[idx], batch.y[idx], batch.z[idx])
+end
+
+function Base.setindex!(batch::MeasureBatch, measure::VectorMeasure, idx::Int)
+    check_coordinate_system(batch, measure)
+    batch.x[idx] = measure.x
+    batch.y[idx] = measure.y
+    batch.z[idx] = measure.z
+    measure
+end
+
+Base.copy(batch::MeasureBatch{T, S}) where {T, S} =
+    MeasureBatch{T, S}(batch.sys, copy(batch.x), copy(batch.y), copy(batch.z))
+
+units(::MeasureBatch{T}) where {T} = units(T)
+
+for (T, c_function) in ((Direction, "convertDirectionBatch"),
+                        (Position,  "convertPositionBatch"),
+                        (Baseline,  "convertBaselineBatch"))
+    @eval function measure(frame::ReferenceFrame, batch::MeasureBatch{$T, S}, newsys::S) where S
+        N = length(batch)
+        x = zeros(N); y = zeros(N); z = zeros(N)
+        ccall(($c_function, libcasacorewrapper), Void,
+              (Cint, Ptr{Float64}, Ptr{Float64}, Ptr{Float64}, Csize_t, Cint, Ref{ReferenceFrame},
+               Ptr{Float64}, Ptr{Float64}, Ptr{Float64}),
+              batch.sys, batch.x, batch.y, batch.z, N, newsys, frame, x, y, z)
+        MeasureBatch{$T, S}(newsys, x, y, z)
+    end
+end
+
+@noinline function epoch_position_error(sys)
+    err("the observer's position must be set in the reference frame to convert to or from $sys")
+end
+
+@noinline nonfinite_time_error() = err("every time must be finite")
+
+"""
+    measure!(output, frame, sys, times, newsys)
+
+Convert an array of times from the epoch coordinate system `sys` into `newsys`, and write the
+converted times into `output` (which may be the same array as `times`). All times are measured in
+seconds (see [`Epoch`](@ref)) and must be finite.
+
+Each distinct time is only converted once, and the same CasaCore conversion engine is reused for
+every time. This makes it cheap to convert the `TIME` column of a measurement set, where every
+baseline of an integration shares the same time. The local sidereal times (`LAST` and `LMST`)
+require the position of the observer to be set in the `frame`.
+
+**Examples:**
+
+``` julia
+frame = ReferenceFrame()
+set!(frame, observatory("OVRO_MMA"))
+times = ms["TIME"]
+lst = measure!(similar(times), frame, epoch"UTC", times, epoch"LAST")
+```
+"""
+function measure!(output::Vector{Float64}, frame::ReferenceFrame, sys::Epochs.System,
+                  times::Vector{Float64}, newsys::Epochs.System)
+    if length(output) != length(times)
+        throw(DimensionMismatch("the output must have the same length as the input"))
+    end
+    # the times are sorted and deduplicated before conversion, which NaN would break
+    all(isfinite, times) || nonfinite_time_error()
+    for s in (sys, newsys)
+        if (s == Epochs.LAST || s == Epochs.LMST) && isnull(frame.position)
+            epoch_position_error(s)
+        end
+    end
+    ccall(("convertEpochBatch", libcasacorewrapper), Void,
+          (Cint, Ptr{Float64}, Csize_t, Cint, Ref{ReferenceFrame}, Ptr{Float64}),
+          sys, times, length(times), newsys, frame, output)
+    output
+end
+
+function measure(frame::ReferenceFrame, sys::Epochs.System, times::Vector{Float64},
+                 newsys::Epochs.System)
+    measure!(similar(times), frame, sys, times, newsys)
+end
+
+function measure(frame::ReferenceFrame, epochs::AbstractVector{Epoch}, newsys::Epochs.System)
+    isempty(epochs) && return Epoch[]
+    sys = first(epochs).sys
+    for epoch in epochs
+        epoch.sys == sys || inconsistent_coordinate_system_error()
+    end
+    times = measure(frame, sys, Float64[epoch.time for epoch in epochs], newsys)
+    Epoch[Epoch(newsys, time) for time in times]
+end
+
+# Vector math over the batch. Every operation accepts either a batch or a single measure on each
+# side, and broadcasts the single measure over the batch.
+
+const BatchOrMeasure = Union{MeasureBatch, VectorMeasure}
+
+coordinates(batch::MeasureBatch, idx) = (batch.x[idx], batch.y[idx], batch.z[idx])
+coordinates(measure::VectorMeasure, idx) = (measure.x, measure.y, measure.z)
+
+batch_length(batch::MeasureBatch) = length(batch)
+batch_length(measure::VectorMeasure) = 1
+function batch_length(lhs, rhs)
+    N = max(batch_length(lhs), batch_length(rhs))
+    if (lhs isa MeasureBatch && length(lhs) != N) || (rhs isa MeasureBatch && length(rhs) != N)
+        throw(DimensionMismatch("batches must have the same length"))
+    end
+    N
+end
+
+measure_type(::MeasureBatch{T}) where {T} = T
+measure_type(::T) where {T<:VectorMeasure} = T
+
+function batch_dot(lhs::BatchOrMeasure, rhs::BatchOrMeasure)
+    check_coordinate_system(lhs, rhs)
+    N = batch_length(lhs, rhs)
+    output = zeros(N)
+    @inbounds for idx = 1:N
+        x1, y1, z1 = coordinates(lhs, idx)
+        x2, y2, z2 = coordinates(rhs, idx)
+        output[idx] = x1*x2 + y1*y2 + z1*z2
+    end
+    output
+end
+
+function Base.dot(lhs::MeasureBatch, rhs::BatchOrMeasure)
+    batch_dot(lhs, rhs) .* (units(measure_type(lhs)) * units(measure_type(rhs)))
+end
+function Base.dot(lhs::VectorMeasure, rhs::MeasureBatch)
+    batch_dot(lhs, rhs) .* (units(measure_type(lhs)) * units(measure_type(rhs)))
+end
+
+function batch_cross(lhs::BatchOrMeasure, rhs::BatchOrMeasure)
+    check_coordinate_system(lhs, rhs)
+    N = batch_length(lhs, rhs)
+    x = zeros(N); y = zeros(N); z = zeros(N)
+    @inbounds for idx = 1:N
+        x1, y1, z1 = coordinates(lhs, idx)
+        x2, y2, z2 = coordinates(rhs, idx)
+        x[idx] = y1*z2 - z1*y2
+        y[idx] = z1*x2 - x1*z2
+        z[idx] = x1*y2 - y1*x2
+    end
+    x, y, z
+end
+
+# Mirror the promotion rules for single measures: the cross product of two directions is an
+# unnormalized direction, and otherwise the result has the type of the operand that isn't a direction.
+function Base.cross(lhs::MeasureBatch, rhs::BatchOrMeasure)
+    batch_cross_measure(lhs, rhs)
+end
+function Base.cross(lhs::VectorMeasure, rhs::MeasureBatch)
+    batch_cross_measure(lhs, rhs)
+end
+
+function batch_cross_measure(lhs, rhs)
+    T = measure_type(lhs)
+    S = measure_type(rhs)
+    x, y, z = batch_cross(lhs, rhs)
+    if T <: AnyDirection && S <: AnyDirection
+        MeasureBatch{UnnormalizedDirection, Directions.System}(lhs.sys, x, y, z)
+    elseif T <: AnyDirection
+        MeasureBatch{S, typeof(rhs.sys)}(rhs.sys, x, y, z)
+    else
+        MeasureBatch{T, typeof(lhs.sys)}(lhs.sys, x, y, z)
+    end
+end
+
+function angle_between(lhs::MeasureBatch{Direction}, rhs::Union{MeasureBatch{Direction}, AnyDirection})
+    rhs = rhs isa UnnormalizedDirection ? Direction(rhs) : rhs
+    acos.(clamp.(batch_dot(lhs, rhs), -1, 1)) .* u"rad"
+end
+angle_between(lhs::AnyDirection, rhs::MeasureBatch{Direction}) = angle_between(rhs, lhs)
+
+function Base.:*(matrix::RotationMatrix, batch::MeasureBatch{T, S}) where {T, S}
+    check_coordinate_system(matrix, batch)
+    N = length(batch)
+    x = zeros(N); y = zeros(N); z = zeros(N)
+    M = matrix.matrix
+    @inbounds for idx = 1:N
+        x1, y1, z1 = batch.x[idx], batch.y[idx], batch.z[idx]
+        x[idx] = M[1, 1]*x1 + M[1, 2]*y1 + M[1, 3]*z1
+        y[idx] = M[2, 1]*x1 + M[2, 2]*y1 + M[2, 3]*z1
+        z[idx] = M[3, 1]*x1 + M[3, 2]*y1 + M[3, 3]*z1
+    end
+    MeasureBatch{T, S}(batch.sys, x, y, z)
+end
@@ -0,0 +1,217 @@
+# Copyright (c) 2015-2017 Michael Eastwood
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+    FastConverter
+
+An approximate direction conversion that is valid over a fixed range of times. The exact CasaCore
+conversion is sampled on a grid of times when the converter is constructed, and each subsequent
+conversion interpolates between the two nearest samples instead of calling CasaCore.
+
+Each sample is stored as a matrix `R` and an offset `b` such that the converted direction is
+`normalize(R*d + b)`. The matrix accounts for precession, nutation, and the rotation of the Earth,
+while the offset accounts for aberration (which is not a rotation).
+
+See also: [`Measures.validate`](@ref)
+"""
+struct FastConverter
+    sys :: Directions.System
+    newsys :: Directions.System
+    epochsys :: Epochs.System
+    start :: Float64 # seconds
+    step  :: Float64 # seconds
+    matrices :: Vector{SMatrix{3, 3, Float64, 9}}
+    offsets  :: Vector{SVector{3, Float64}}
+    tolerance :: Float64 # radians
+end
+
+# The fastest varying part of any conversion to a frame that is fixed to the Earth is the rotation
+# of the Earth itself. Linear interpolation of a rotation through a small angle θ has an error of
+# roughly θ²/8, which lets us guess a grid spacing before validating it.
+const earth_rotation_rate = 7.292115e-5 # rad / s
+
+"""
+    FastConverter(frame, sys, newsys, start, stop; tolerance=1e-7u"rad")
+
+Construct an approximate converter from the direction coordinate system `sys` to `newsys` that is
+valid between the epochs `start` and `stop`.
+
+**Arguments:**
+
+* `frame` - the `ReferenceFrame` used to sample the exact conversion (the epoch is ignored)
+* `sys` - the coordinate system of the directions that will be converted
+* `newsys` - the coordinate system the directions will be converted into
+* `start` - the first `Epoch` at which the converter will be used
+* `stop` - the last `Epoch` at which the converter will be used
+
+**Keyword Arguments:**
+
+* `tolerance` - the maximum acceptable error in the converted directions
+
+The grid of samples is refined until the error at the midpoint between every pair of samples is
+smaller than `tolerance`.
+
+**Usage:**
+
+``` julia
+frame = ReferenceFrame()
+set!(frame, observatory("OVRO_MMA"))
+start = Epoch(epoch"UTC", 50237.0u"d")
+stop  = Epoch(epoch"UTC", 50237.1u"d")
+converter = FastConverter(frame, dir"J2000", dir"AZEL", start, stop)
+azel = measure(converter, Direction(dir"J2000", "12h00m", "45d00m"),
+               Epoch(epoch"UTC", 50237.05u"d"))
+```
+
+See also: [`Measures.validate`](@ref)
+"""
+function FastConverter(frame::ReferenceFrame, sys::Directions.System, newsys::Directions.System,
+                       start::Epoch, stop::Epoch; tolerance::Angle=1e-7u"rad")
+    check_coordinate_system(start, stop)
+    stop.time > start.time || err("the stop epoch must come after the start epoch")
+    tol = ustrip(uconvert(u"rad", tolerance))
+    tol > 0 || err("the tolerance must be positive")
+    frame = ReferenceFrame(frame.epoch, frame.direction, frame.position)
+    step = min(sqrt(8tol)/earth_rotation_rate, stop.time - start.time)
+    while true
+        converter = sample_conversion(frame, sys, newsys, start, stop, step, tol)
+        midpoint_error(frame, converter) < tol && return converter
+        step /= 2
+        step > 1e-3 || err("unable to reach the requested tolerance")
+    end
+end
+
+# The direction-independent part of the conversion is recovered from the conversion of the six
+# coordinate axes. If the exact conversion is `normalize(R*d + b)` with `b` small, then to first
+# order the conversion of ±eᵢ is ±Rᵢ + b⊥, where b⊥ is the part of b perpendicular to Rᵢ. Summing
+# over the three axes recovers b.
+const probe_directions = (( 1, 0, 0), (0,  1, 0), (0, 0,  1),
+                          (-1, 0, 0), (0, -1, 0), (0, 0, -1))
+
+function sample_conversion(frame, sys, newsys, start, stop, step, tol)
+    N = ceil(Int, (stop.time - start.time) / step) + 1
+    matrices = Vector{SMatrix{3, 3, Float64, 9}}(N)
+    offsets  = Vector{SVector{3, Float64}}(N)
+    probes = DirectionBatch(sys, [probe[1] for probe in probe_directions],
+                                 [probe[2] for probe in probe_directions],
+                                 [probe[3] for probe in probe_directions])
+    for idx = 1:N
+        set!(frame, Epoch(start.sys, start.time + (idx-1)*step))
+        converted = measure(frame, probes, newsys)
+        plus  = @SMatrix [converted.x[1] converted.x[2] converted.x[3];
+                          converted.y[1] converted.y[2] converted.y[3];
+                          converted.z[1] converted.z[2] converted.z[3]]
+        minus = @SMatrix [converted.x[4] converted.x[5] converted.x[6];
+                          converted.y[4] converted.y[5] converted.y[6];
+                          converted.z[4] converted.z[5] converted.z[6]]
+        total = plus + minus
+        matrices[idx] = (plus - minus) / 2
+        offsets[idx]  = @SVector([total[1, 1] + total[1, 2] + total[1, 3],
+                                  total[2, 1] + total[2, 2] + total[2, 3],
+                                  total[3, 1] + total[3, 2] + total[3, 3]]) / 4
+    end
+    FastConverter(sys, newsys, start.sys, start.time, step, matrices, offsets, tol)
+end
+
+function midpoint_error(frame, converter)
+    # the probes are chosen away from the coordinate axes so that they are not sampled exactly
+    probes = DirectionBatch(converter.sys, [1, -1, 1, -1], [1, 1, -1, -1], [1, -1, -1, 1])
+    error = 0.0
+    for idx = 1:length(converter.matrices)-1
+        epoch = Epoch(converter.epochsys, converter.start + (idx-0.5)*converter.step)
+        error = max(error, batch_error(frame, converter, probes, epoch))
+    end
+    error
+end
+
+function batch_error(frame, converter, directions, epoch)
+    set!(frame, epoch)
+    exact  = measure(frame, directions, converter.newsys)
+    approx = measure(converter, directions, epoch)
+    # the chord length is a more precise measure of a small angle than the arccosine of the dot
+    # product
+    maximum(hypot.(exact.x .- approx.x, exact.y .- approx.y, exact.z .- approx.z))
+end
+
+@noinline epoch_out_of_range_error() = err("epoch is outside the range of the converter")
+
+function interpolation_weights(converter::FastConverter, epoch::Epoch)
+    epoch.sys == converter.epochsys || inconsistent_coordinate_system_error()
+    s = (epoch.time - converter.start) / converter.step
+    N = length(converter.matrices)
+    # allow a little slop at either end for round-off in the epoch
+    -1e-6 ≤ s ≤ N - 1 + 1e-6 || epoch_out_of_range_error()
+    idx = clamp(floor(Int, s) + 1, 1, N-1)
+    weight = clamp(s - (idx-1), 0.0, 1.0)
+    idx, weight
+end
+
+function interpolate(converter::FastConverter, idx, weight)
+    R = (1-weight)*converter.matrices[idx] + weight*converter.matrices[idx+1]
+    b = (1-weight)*converter.offsets[idx]  + weight*converter.offsets[idx+1]
+    R, b
+end
+
+function measure(converter::FastConverter, direction::AnyDirection, epoch::Epoch)
+    direction.sys == converter.sys || inconsistent_coordinate_system_error()
+    R, b = interpolate(converter, interpolation_weights(converter, epoch)...)
+    v = R * @SVector([direction.x, direction.y, direction.z]) + b
+    Direction(converter.newsys, v[1], v[2], v[3])
+end
+
+function measure(converter::FastConverter, batch::DirectionBatch, epoch::Epoch)
+    batch.sys == converter.sys || inconsistent_coordinate_system_error()
+    R, b = interpolate(converter, interpolation_weights(converter, epoch)...)
+    N = length(batch)
+    x = zeros(N); y = zeros(N); z = zeros(N)
+    @inbounds for idx = 1:N
+        v = R * @SVector([batch.x[idx], batch.y[idx], batch.z[idx]]) + b
+        x[idx] = v[1]
+        y[idx] = v[2]
+        z[idx] = v[3]
+    end
+    DirectionBatch(converter.newsys, x, y, z)
+end
+
+"""
+    Measures.validate(converter, frame; directions=100, epochs=100)
+
+Compare the approximate conversion against the exact conversion performed by CasaCore, and return
+the largest angular error that was found. The comparison is made for `directions` random directions
+at `epochs` random times within the range of the converter.
+
+**Arguments:**
+
+* `converter` - the `FastConverter` to validate
+* `frame` - the `ReferenceFrame` that was used to construct the converter
+
+**Keyword Arguments:**
+
+* `directions` - the number of random directions to test
+* `epochs` - the number of random epochs to test
+
+See also: [`FastConverter`](@ref)
+"""
+function validate(converter::FastConverter, frame::ReferenceFrame; directions=100, epochs=100)
+    frame = ReferenceFrame(frame.epoch, frame.direction, frame.position)
+    batch = DirectionBatch(converter.sys, randn(directions), randn(directions), randn(directions))
+    duration = converter.step * (length(converter.matrices) - 1)
+    error = 0.0
+    for idx = 1:epochs
+        epoch = Epoch(converter.epochsys, converter.start + rand()*duration)
+        error = max(error, batch_error(frame, converter, batch, epoch))
+    end
+    error * u"rad"
+end
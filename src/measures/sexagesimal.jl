@@ -103,3 +103,73 @@ function sexagesimal(angle::T; hours::Bool = false, digits::Int = 0) where T
     string(s1, s2, s3)
 end
 
+
+"""
+    sexagesimal(strings; strict=true)
+
+Parse an array of angles given in sexagesimal format. This is much faster than parsing each string
+individually when there are many angles (for example when loading a source catalog).
+
+In addition to the formats understood by `sexagesimal(string)`, the colon separated format
+`"12:34:56.7"` (hours) and the dot separated format `"+12.34.56.7"` (degrees) are also
+understood. The entire string (ignoring surrounding whitespace) must match one of these formats.
+The colon separated format is only accepted without a sign and below 24h (so a declination such
+as `"-30:00:00"` is reported as unparseable instead of being read as hours).
+
+* If `strict` is `true` an error listing every string that could not be parsed is thrown.
+* If `strict` is `false` the strings that could not be parsed are returned as `NaN`.
+
+**Examples:**
+
+``` julia
+sexagesimal(["12h34m56.7s", "12:34:56.7"])
+sexagesimal(["+12d34m56.7s", "+12.34.56.7"])
+```
+"""
+function sexagesimal(strings::AbstractArray{<:AbstractString}; strict::Bool=true)
+    c_strings = String[string for string in strings]
+    output = zeros(Float64, size(strings))
+    status = zeros(Cint, size(strings))
+    ccall((:parse_sexagesimal, libcasacorewrapper), Void,
+          (Ptr{Ptr{Cchar}}, Csize_t, Ptr{Float64}, Ptr{Cint}),
+          c_strings, length(c_strings), output, status)
+    if strict && any(status .!= 0)
+        bad = find(status .!= 0)
+        list = join(bad[1:min(end, 10)], ", ")
+        length(bad) > 10 && (list *= ", ...")
+        err("Unknown sexagesimal format in $(length(bad)) element(s) (indices: $list).")
+    end
+    output
+end
+
+"""
+    sexagesimal(angles; hours = false, digits = 0)
+
+Construct sexagesimal strings from an array of angles. The output is identical to calling
+`sexagesimal(angle; hours = hours, digits = digits)` on each angle individually.
+"""
+function sexagesimal(angles::AbstractArray{T}; hours::Bool = false, digits::Int = 0) where T
+    if T <: Angle
+        radians = Float64[uconvert(u"rad", angle) |> ustrip for angle in angles]
+    else
+        radians = Float64[angle for angle in angles]
+    end
+    if hours
+        # `mod2pi` is more precise than what is easily available in the wrapper
+        radians .= mod2pi.(radians)
+    end
+    all(isfinite, radians) || err("Cannot construct a sexagesimal string from a non-finite angle.")
+    0 ≤ digits ≤ 13 || err("The number of digits must be between 0 and 13.")
+    width = ccall((:sexagesimal_string_width, libcasacorewrapper), Cint, ())
+    buffer = Vector{UInt8}(width*length(radians))
+    lengths = zeros(Cint, length(radians))
+    ccall((:format_sexagesimal, libcasacorewrapper), Void,
+          (Ptr{Float64}, Csize_t, Bool, Cint, Ptr{UInt8}, Ptr{Cint}),
+          radians, length(radians), hours, digits, buffer, lengths)
+    output = similar(angles, String)
+    for idx = 1:length(radians)
+        offset = (idx-1)*width
+        output[idx] = String(buffer[offset+1:offset+lengths[idx]])
+    end
+    output
+end
@@ -0,0 +1,79 @@
+# Copyright (c) 2015-2017 Michael Eastwood
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+    WarmupReport
+
+Records which of the CasaCore measures data tables were successfully loaded by
+[`Measures.warmup!`](@ref).
+
+**Fields:**
+
+* `leap_seconds` - the table of leap seconds (TAI-UTC)
+* `iers` - the IERS Earth orientation parameters
+* `ephemerides` - the JPL DE200 and DE405 ephemerides
+* `observatories` - the list of observatory positions
+* `conversions` - a sample of epoch, direction, and position conversions succeeded
+"""
+struct WarmupReport
+    leap_seconds  :: Bool
+    iers          :: Bool
+    ephemerides   :: Bool
+    observatories :: Bool
+    conversions   :: Bool
+end
+
+WarmupReport() = WarmupReport(false, false, false, false, false)
+
+function Base.show(io::IO, report::WarmupReport)
+    print(io, "WarmupReport(")
+    names = fieldnames(report)
+    for (idx, name) in enumerate(names)
+        print(io, name, " = ", getfield(report, name))
+        idx == length(names) || print(io, ", ")
+    end
+    print(io, ")")
+end
+
+"""
+    Measures.warmup!(; date=now())
+
+Load every data table used by CasaCore to convert between coordinate systems. Otherwise CasaCore
+loads each table the first time it is needed, which can add several seconds to the first
+conversion. The tables remain loaded for the lifetime of the process.
+
+**Keyword Arguments:**
+
+* `date` - the date at which to query the tables, which should be close to the dates that will be
+           used in subsequent conversions
+
+The tables are read from the directory given by `measures.directory` in the user's `.casarc` (or
+from the default location compiled into CasaCore). Returns a [`Measures.WarmupReport`](@ref)
+listing the tables that were loaded.
+
+**Usage:**
+
+``` julia
+report = Measures.warmup!()
+report.iers || warn("IERS tables are missing, conversions will be less accurate")
+```
+"""
+function warmup!(; date::DateTime=now())
+    mjd = Dates.datetime2julian(date) - 2400000.5
+    report = Ref(WarmupReport())
+    ccall(("measures_warmup", libcasacorewrapper), Void,
+          (Cdouble, Ref{WarmupReport}), mjd, report)
+    report[]
+end
@@ -0,0 +1,120 @@
+# Copyright (c) 2015-2017 Michael Eastwood
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# Opt-in instrumentation of the entry points in libcasacorewrapper.
+
+const libcasacorewrapper = normpath(joinpath(@__DIR__, "..", "deps", "src",
+                                             "libcasacorewrapper.so"))
+
+# This struct must mirror its corresponding C++ type.
+struct StatsRecord
+    name        :: Ptr{Cchar}
+    calls       :: UInt64
+    bytes       :: UInt64
+    total_ns    :: UInt64
+    copy_ns     :: UInt64
+    allocations :: UInt64
+end
+
+"""
+    struct EntryStats
+
+Statistics collected for one of the wrapper's entry points.
+
+**Fields:**
+
+- `calls` - the number of times the entry point was called
+- `bytes` - the number of bytes copied between CasaCore and Julia
+- `time_casacore` - the time spent in CasaCore (in seconds)
+- `time_copying` - the time spent copying data between CasaCore and Julia (in seconds)
+- `allocations` - the number of allocations made while copying data
+"""
+struct EntryStats
+    calls         :: Int
+    bytes         :: Int
+    time_casacore :: Float64
+    time_copying  :: Float64
+    allocations   :: Int
+end
+
+"""
+    CasaCore.enable_stats(enable=true)
+
+Enable (or disable) the collection of statistics in the wrapper. Statistics can also be enabled by
+setting the environment variable `CASACORE_JL_STATS=1` before loading CasaCore.
+
+**See also:** [`CasaCore.stats`](@ref), [`CasaCore.reset_stats`](@ref)
+"""
+function enable_stats(enable::Bool=true)
+    ccall((:stats_enable, libcasacorewrapper), Void, (Bool,), enable)
+    enable
+end
+
+"Returns `true` if statistics are currently being collected."
+function stats_enabled()
+    ccall((:stats_is_enabled, libcasacorewrapper), Bool, ())
+end
+
+"""
+    CasaCore.stats()
+
+Returns a dictionary mapping the name of each of the wrapper's entry points to the statistics
+collected for that entry point (see [`CasaCore.EntryStats`](@ref)). Entry points that have not been
+called since the statistics were last reset are omitted.
+
+**Usage:**
+
+```julia
+CasaCore.enable_stats()
+table["DATA"]
+stats = CasaCore.stats()
+stats["get_column_complex"].time_copying
+```
+
+**See also:** [`CasaCore.enable_stats`](@ref), [`CasaCore.reset_stats`](@ref)
+"""
+function stats()
+    output = Dict{String, EntryStats}()
+    N = ccall((:stats_num_entries, libcasacorewrapper), Cint, ())
+    record = Ref{StatsRecord}()
+    for index = 0:N-1
+        found = ccall((:stats_get_entry, libcasacorewrapper), Bool,
+                      (Cint, Ref{StatsRecord}), index, record)
+        found || continue
+        r = record[]
+        r.calls == 0 && continue
+        name = unsafe_string(r.name)
+        time_copying  = r.copy_ns * 1e-9
+        time_casacore = (r.total_ns - min(r.copy_ns, r.total_ns)) * 1e-9
+        output[name] = EntryStats(r.calls, r.bytes, time_casacore, time_copying, r.allocations)
+    end
+    output
+end
+
+"""
+    CasaCore.reset_stats()
+
+Reset all of the statistics collected in the wrapper to zero.
+
+**See also:** [`CasaCore.enable_stats`](@ref), [`CasaCore.stats`](@ref)
+"""
+function reset_stats()
+    ccall((:stats_reset, libcasacorewrapper), Void, ())
+end
+
+function Base.show(io::IO, stats::EntryStats)
+    @printf(io, "%d calls, %d bytes, %.6f s in CasaCore, %.6f s copying, %d allocations",
+            stats.calls, stats.bytes, stats.time_casacore, stats.time_copying, stats.allocations)
+end
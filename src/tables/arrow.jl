@@ -0,0 +1,124 @@
+# Copyright (c) 2015-2017 Michael Eastwood
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+@noinline function arrow_unavailable_error()
+    err("CasaCore.jl was built without Arrow support (rebuild with CASACORE_JL_ARROW=1)")
+end
+
+"""
+    Tables.arrow_available()
+
+Returns `true` if the wrapper was built with support for Apache Arrow files.
+"""
+function arrow_available()
+    handle = Libdl.dlopen(libcasacorewrapper)
+    Libdl.dlsym_e(handle, :arrow_export_table) != C_NULL
+end
+
+"""
+    Tables.export_arrow(table, path; columns=nothing, rows=nothing, chunk_rows=65536)
+
+Write the columns of a table to an Apache Arrow IPC file. The table is streamed to the file in
+chunks of rows, and each chunk becomes one record batch.
+
+Array columns are written as fixed size lists (with one list per row), and complex numbers are
+written as fixed size lists of two floats. The shape of each array column is recorded in the
+`casacore.shape` metadata of its field. Every exported array column must have the same shape in
+every exported row. If the export fails part way through, the partially written file is removed.
+
+**Arguments:**
+
+- `table` - the table to export
+- `path` - the path of the Arrow file that will be created
+
+**Keyword Arguments:**
+
+- `columns` - a list of the columns to export (all of the columns are exported by default)
+- `rows` - a range of rows to export (all of the rows are exported by default)
+- `chunk_rows` - the number of rows in each record batch
+
+This function is only available if the wrapper was built with `CASACORE_JL_ARROW=1`.
+
+**Usage:**
+
+```julia
+table = Tables.open("/tmp/my-table.ms")
+Tables.export_arrow(table, "/tmp/my-table.arrow", columns=["TIME", "DATA"], rows=1:1000)
+```
+
+**See also:** [`Tables.import_arrow`](@ref)
+"""
+function export_arrow(table::Table, path; columns=nothing, rows=nothing, chunk_rows=65536)
+    arrow_available() || arrow_unavailable_error()
+    isopen(table) || table_closed_error()
+    if columns === nothing
+        c_columns = String[]
+    else
+        c_columns = collect(String, columns)
+        for column in c_columns
+            column_exists(table, column) || column_missing_error(column)
+        end
+    end
+    N = num_rows(table)
+    if rows === nothing
+        rows = 1:N
+    end
+    rows = convert(UnitRange{Int}, rows)
+    if !isempty(rows) && (first(rows) ≤ 0 || last(rows) ≥ N+1)
+        row_out_of_bounds_error(rows)
+    end
+    chunk_rows ≥ 1 || err("chunk_rows must be positive")
+    message = ccall((:arrow_export_table, libcasacorewrapper), Ptr{Cchar},
+                    (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{Ptr{Cchar}}, Cint, Cuint, Cuint, Cuint),
+                    table, path, c_columns, length(c_columns),
+                    first(rows)-1, first(rows)-1+length(rows), chunk_rows)
+    message == C_NULL || err(wrap_value(message))
+    path
+end
+
+"""
+    Tables.import_arrow(arrow_path, table_path)
+
+Create a new table from the record batches in an Apache Arrow IPC file. The new table is opened
+for writing and returned.
+
+Fields written by [`Tables.export_arrow`](@ref) are restored with their original element type and
+shape. Fixed size lists written by other tools are imported as one dimensional array columns.
+
+Tables have no notion of a missing value, so fields containing nulls are rejected. If the import
+fails, no table is left behind at `table_path`.
+
+**Arguments:**
+
+- `arrow_path` - the path to the Arrow file
+- `table_path` - the path where the new table will be created
+
+This function is only available if the wrapper was built with `CASACORE_JL_ARROW=1`.
+
+**See also:** [`Tables.export_arrow`](@ref)
+"""
+function import_arrow(arrow_path, table_path)
+    arrow_available() || arrow_unavailable_error()
+    isfile(arrow_path) || err("Arrow file does not exist.")
+    table_path = table_fix_path(table_path)
+    if isfile(table_path) || isdir(table_path)
+        table_exists_error()
+    end
+    message = Ref{Ptr{Cchar}}(C_NULL)
+    ptr = ccall((:arrow_import_table, libcasacorewrapper), Ptr{CasaCoreTable},
+                (Ptr{Cchar}, Ptr{Cchar}, Ref{Ptr{Cchar}}), arrow_path, table_path, message)
+    message[] == C_NULL || err(wrap_value(message[]))
+    Table(table_path, readwrite, ptr)
+end
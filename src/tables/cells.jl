@@ -17,6 +17,10 @@ function Base.getindex(table::Table, column::String, row::Integer)
     isopen(table) || table_closed_error()
     check_column_row(table, column, row)
     T, shape = column_info(table, column)
+    if is_variable_shape(table, column)
+        # the shape of the column is inferred from the first row, which might be different
+        shape = (cell_shape(table, column, row)..., 1)
+    end
     read_cell(table, column, row, T, shape[1:end-1])
 end
 
@@ -25,10 +29,35 @@ function Base.setindex!(table::Table, value, column::String, row::Integer)
     iswritable(table) || table_readonly_error()
     check_column_row(table, column, row)
     T, shape = column_info(table, column)
-    check_cell(value, column, T, shape)
+    if is_variable_shape(table, column)
+        # any shape is allowed, but it still needs to be an array of the right type and dimension
+        value isa Array || column_shape_error(column)
+        T == eltype(value) || column_element_type_error(column)
+        check_ndim(table, column, ndims(value))
+    else
+        check_cell(value, column, T, shape)
+    end
     write_cell!(table, value, column, row)
 end
 
+@noinline function cell_undefined_error(column, row)
+    err("row $row of column \"$column\" is undefined")
+end
+
+function is_variable_shape(table, column)
+    !column_is_scalar(table, column) && !column_is_fixed_shape(table, column)
+end
+
+function cell_shape(table, column, row)
+    ndim = Ref{Cint}(0)
+    shape_ptr = ccall((:cell_shape, libcasacorewrapper), Ptr{Cint},
+                      (Ptr{CasaCoreTable}, Ptr{Cchar}, Cuint, Ref{Cint}),
+                      table, column, row-1, ndim)
+    shape = unsafe_wrap(Vector{Cint}, shape_ptr, ndim[], true)
+    ndim[] == 0 && cell_undefined_error(column, row)
+    tuple(shape...)
+end
+
 function check_column_row(table, column, row)
     if !column_exists(table, column)
         column_missing_error(column)
@@ -82,6 +111,7 @@ for T in typelist
         # Subtract 1 from the row number to convert to a 0-based indexing scheme
         ccall(($c_put_cell_scalar, libcasacorewrapper), Void,
               (Ptr{CasaCoreTable}, Ptr{Cchar}, Cuint, $Tc), table, column, row-1, value)
+        written!(table, payload_bytes(value))
         value
     end
 
@@ -91,6 +121,7 @@ for T in typelist
         ccall(($c_put_cell_array, libcasacorewrapper), Void,
               (Ptr{CasaCoreTable}, Ptr{Cchar}, Cuint, Ptr{$Tc}, Ptr{Cint}, Cint),
               table, column, row-1, value, shape, length(shape))
+        written!(table, payload_bytes(value))
         value
     end
 end
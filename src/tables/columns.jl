@@ -29,6 +29,17 @@ end
     err("array shape mismatch for column \"$column\"")
 end
 
+@noinline function tile_shape_error(tile_shape, shape)
+    err("tile shape $tile_shape must have the same number of dimensions as the column $shape")
+end
+
+@noinline tiled_string_column_error() = err("string columns cannot be tiled")
+
+@noinline function column_ragged_error(column)
+    err("the cells of column \"$column\" do not all have the same shape "*
+        "(use `Tables.read_ragged` to read this column)")
+end
+
 """
     Tables.num_columns(table)
 
@@ -72,6 +83,7 @@ for T in typelist
     typestr = type2str[T]
     c_add_scalar_column = String(Symbol(:add_scalar_column_, typestr))
     c_add_array_column  = String(Symbol(:add_array_column_, typestr))
+    c_add_tiled_array_column = String(Symbol(:add_tiled_array_column_, typestr))
 
     @eval function add_column!(table::Table, column::String, ::Type{$T}, shape::Tuple{Int})
         isopen(table) || table_closed_error()
@@ -85,7 +97,10 @@ for T in typelist
         column
     end
 
-    @eval function add_column!(table::Table, column::String, ::Type{$T}, shape::Tuple)
+    # If a `tile_shape` is given (including the row axis), the column is stored with its own tiled
+    # storage manager instead of the default storage manager.
+    @eval function add_column!(table::Table, column::String, ::Type{$T}, shape::Tuple;
+                               tile_shape::Tuple=())
         isopen(table) || table_closed_error()
         iswritable(table) || table_readonly_error()
         Nrows = num_rows(table)
@@ -93,9 +108,18 @@ for T in typelist
             column_length_mismatch_error(shape[end], Nrows)
         end
         cell_shape = convert(Vector{Cint}, collect(shape[1:end-1]))
-        ccall(($c_add_array_column, libcasacorewrapper), Void,
-              (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{Cint}, Cint),
-              table, column, cell_shape, length(cell_shape))
+        if isempty(tile_shape)
+            ccall(($c_add_array_column, libcasacorewrapper), Void,
+                  (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{Cint}, Cint),
+                  table, column, cell_shape, length(cell_shape))
+        else
+            $(T === String ? :(tiled_string_column_error()) : nothing)
+            length(tile_shape) == length(shape) || tile_shape_error(tile_shape, shape)
+            c_tile_shape = convert(Vector{Cint}, collect(tile_shape))
+            ccall(($c_add_tiled_array_column, libcasacorewrapper), Void,
+                  (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{Cint}, Cint, Ptr{Cint}, Cint),
+                  table, column, cell_shape, length(cell_shape), c_tile_shape, length(c_tile_shape))
+        end
         column
     end
 end
@@ -133,6 +157,7 @@ function remove_column!(table::Table, column::String)
     iswritable(table) || table_readonly_error()
     ccall(("remove_column", libcasacorewrapper), Void,
           (Ptr{CasaCoreTable}, Ptr{Cchar}), table, column)
+    written!(table, 0)
 end
 
 "Get the column element type and shape."
@@ -155,6 +180,14 @@ function column_is_fixed_shape(table::Table, column::String)
           table, column)
 end
 
+"Get the type of the data manager that stores the column (eg. \"StandardStMan\")."
+function column_data_manager(table::Table, column::String)
+    isopen(table) || table_closed_error()
+    column_exists(table, column) || column_missing_error(column)
+    ccall((:column_data_manager, libcasacorewrapper), Ptr{Cchar},
+          (Ptr{CasaCoreTable}, Ptr{Cchar}), table, column) |> wrap_value
+end
+
 "Check to see if the column shape can be changed."
 function column_can_change_shape(table::Table, column::String)
     ccall((:column_can_change_shape, libcasacorewrapper), Bool,
@@ -168,6 +201,9 @@ function Base.getindex(table::Table, column::String)
         column_missing_error(column)
     end
     T, shape = column_info(table, column)
+    if !column_is_scalar(table, column) && !column_is_fixed_shape(table, column)
+        column_has_uniform_shape(table, column) || column_ragged_error(column)
+    end
     read_column(table, column, T, shape)
 end
 
@@ -207,7 +243,60 @@ for T in typelist
         ccall(($c_put_column, libcasacorewrapper), Void,
               (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{$Tc}, Ptr{Cint}, Cint),
               table, column, value, shape, length(shape))
+        written!(table, payload_bytes(value))
         value
     end
 end
 
+
+"""
+    Tables.read_bitarray(table, column)
+
+Read a boolean column (for example `FLAG` or `FLAG_ROW`) as a `BitArray`.
+
+A `BitArray` uses one bit per element instead of the one byte per element used by `Array{Bool}`,
+and the conversion happens in blocks of rows so that the full column is never held in memory at one
+byte per element. `BitArray`s can also be written to a boolean column with `table[column] =
+bitarray`.
+
+**Arguments:**
+
+- `table` - the relevant table
+- `column` - the name of the boolean column
+
+**Usage:**
+
+```jldoctest
+julia> table = Tables.create("/tmp/my-table.ms")
+       Tables.add_rows!(table, 3)
+       table["FLAG_ROW"] = BitArray([true, false, true])
+       Tables.read_bitarray(table, "FLAG_ROW")
+3-element BitArray{1}:
+  true
+ false
+  true
+
+julia> Tables.delete(table)
+```
+"""
+function read_bitarray(table::Table, column::String)
+    isopen(table) || table_closed_error()
+    if !column_exists(table, column)
+        column_missing_error(column)
+    end
+    T, shape = column_info(table, column)
+    T == Bool || column_element_type_error(column)
+    output = BitArray(shape)
+    ccall((:get_column_bits, libcasacorewrapper), Void,
+          (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{UInt64}), table, column, output.chunks)
+    output
+end
+
+function write_column!(table::Table, value::BitArray, column::String)
+    shape = convert(Vector{Cint}, collect(size(value)))
+    ccall((:put_column_bits, libcasacorewrapper), Void,
+          (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{UInt64}, Ptr{Cint}, Cint),
+          table, column, value.chunks, shape, length(shape))
+    written!(table, payload_bytes(value))
+    value
+end
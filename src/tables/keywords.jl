@@ -117,6 +117,7 @@ function remove_keyword!(table::Table, keyword::Keyword)
     iswritable(table) || table_readonly_error()
     ccall((:remove_keyword, libcasacorewrapper), Void,
           (Ptr{CasaCoreTable}, Ptr{Cchar}), table, keyword)
+    written!(table, 0)
     keyword
 end
 
@@ -125,6 +126,7 @@ function remove_keyword!(table::Table, column::String, keyword::Keyword)
     iswritable(table) || table_readonly_error()
     ccall((:remove_column_keyword, libcasacorewrapper), Void,
           (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{Cchar}), table, column, keyword)
+    written!(table, 0)
 end
 
 "Get the keyword element type and shape."
@@ -169,7 +171,9 @@ function Base.setindex!(table::Table, value, keyword::Keyword)
             keyword_element_type_error(keyword)
         end
     end
-    write_keyword!(table, value, keyword)
+    result = write_keyword!(table, value, keyword)
+    written!(table, payload_bytes(value))
+    result
 end
 
 function Base.getindex(table::Table, column::String, keyword::Keyword)
@@ -196,7 +200,9 @@ function Base.setindex!(table::Table, value, column::String, keyword::Keyword)
             keyword_element_type_error(keyword)
         end
     end
-    write_keyword!(table, value, column, keyword)
+    result = write_keyword!(table, value, column, keyword)
+    written!(table, payload_bytes(value))
+    result
 end
 
 for T in typelist
@@ -286,3 +292,209 @@ function write_keyword!(table::Table, value::Table, keyword::Keyword)
     value
 end
 
+
+# Bulk keyword transfer
+#
+# The entire keyword set is serialized into a single buffer on the C++ side (see
+# deps/src/tables/records.cpp for a description of the format). This is much faster than reading
+# each keyword individually when there are many keywords.
+
+@noinline function keyword_set_type_error(keyword, T)
+    err("keyword \"$keyword\" has unsupported type $T")
+end
+
+const type2enum = Dict(Bool    => TpBool,    Int32   => TpInt,
+                       Float32 => TpFloat,   Float64 => TpDouble,
+                       Complex64 => TpComplex, String  => TpString)
+
+"""
+    Tables.read_keywords(table)
+    Tables.read_keywords(table, column)
+
+Read every keyword associated with the table (or the column of the table) with a single call.
+
+Nested records are returned as nested dictionaries. Keywords that refer to subtables are returned as
+the string `"Table: <path>"` so that the subtables do not need to be opened. Keywords with types that
+have no Julia equivalent are returned as `nothing`.
+
+**Arguments:**
+
+- `table` - the relevant table
+- `column` - (optional) read the keywords associated with this column instead
+
+**Usage:**
+
+```jldoctest
+julia> table = Tables.create("/tmp/my-table.ms")
+       table[kw"MS_VERSION"] = 2.0
+       table[kw"TELESCOPE"] = "OVRO-LWA"
+       keywords = Tables.read_keywords(table)
+       keywords["TELESCOPE"]
+"OVRO-LWA"
+
+julia> Tables.delete(table)
+```
+
+**See also:** [`Tables.write_keywords!`](@ref), [`Tables.num_keywords`](@ref)
+"""
+function read_keywords(table::Table)
+    isopen(table) || table_closed_error()
+    length = Ref{Csize_t}(0)
+    ptr = ccall((:get_keyword_set, libcasacorewrapper), Ptr{UInt8},
+                (Ptr{CasaCoreTable}, Ref{Csize_t}), table, length)
+    decode_record(IOBuffer(unsafe_wrap(Vector{UInt8}, ptr, length[], true)))
+end
+
+function read_keywords(table::Table, column::String)
+    isopen(table) || table_closed_error()
+    column_exists(table, column) || column_missing_error(column)
+    length = Ref{Csize_t}(0)
+    ptr = ccall((:get_column_keyword_set, libcasacorewrapper), Ptr{UInt8},
+                (Ptr{CasaCoreTable}, Ptr{Cchar}, Ref{Csize_t}), table, column, length)
+    decode_record(IOBuffer(unsafe_wrap(Vector{UInt8}, ptr, length[], true)))
+end
+
+"""
+    Tables.write_keywords!(table, keywords)
+    Tables.write_keywords!(table, column, keywords)
+
+Write every keyword in the given dictionary to the table (or the column of the table) with a single
+call. Existing keywords with the same name are overwritten, and all other keywords are left alone.
+
+Values may be any of the keyword types supported by `table[kw"..."] = value`, arrays of these
+types, nested dictionaries (written as records), or tables (written as subtables).
+
+**Arguments:**
+
+- `table` - the relevant table
+- `column` - (optional) write the keywords to this column instead
+- `keywords` - a dictionary mapping keyword names to values
+
+**Usage:**
+
+```jldoctest
+julia> table = Tables.create("/tmp/my-table.ms")
+       Tables.write_keywords!(table, Dict("MS_VERSION" => 2.0, "TELESCOPE" => "OVRO-LWA"))
+       table[kw"TELESCOPE"]
+"OVRO-LWA"
+
+julia> Tables.delete(table)
+```
+
+**See also:** [`Tables.read_keywords`](@ref), [`Tables.remove_keyword!`](@ref)
+"""
+function write_keywords!(table::Table, keywords::Associative)
+    isopen(table) || table_closed_error()
+    iswritable(table) || table_readonly_error()
+    buffer = encode_record(keywords)
+    ccall((:put_keyword_set, libcasacorewrapper), Void,
+          (Ptr{CasaCoreTable}, Ptr{UInt8}), table, buffer)
+    written!(table, sizeof(buffer))
+    keywords
+end
+
+function write_keywords!(table::Table, column::String, keywords::Associative)
+    isopen(table) || table_closed_error()
+    iswritable(table) || table_readonly_error()
+    column_exists(table, column) || column_missing_error(column)
+    buffer = encode_record(keywords)
+    ccall((:put_column_keyword_set, libcasacorewrapper), Void,
+          (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{UInt8}), table, column, buffer)
+    written!(table, sizeof(buffer))
+    keywords
+end
+
+decode_string(io) = String(read(io, read(io, Int32)))
+
+function decode_array(io, ::Type{T}) where T
+    ndim  = read(io, Int32)
+    shape = ntuple(i -> Int(read(io, Int32)), ndim)
+    array = Array{T}(shape)
+    read!(io, array)
+end
+
+function decode_array(io, ::Type{String})
+    ndim  = read(io, Int32)
+    shape = ntuple(i -> Int(read(io, Int32)), ndim)
+    array = Array{String}(shape)
+    for idx in eachindex(array)
+        array[idx] = decode_string(io)
+    end
+    array
+end
+
+function decode_record(io)
+    record = Dict{String, Any}()
+    N = read(io, Int32)
+    for idx = 1:N
+        name = decode_string(io)
+        record[name] = decode_value(io, TypeEnum(read(io, Int32)))
+    end
+    record
+end
+
+function decode_value(io, type::TypeEnum)
+    if type == TpString || type == TpTable
+        return decode_string(io)
+    elseif type == TpRecord
+        return decode_record(io)
+    elseif type == TpOther
+        return nothing
+    end
+    T = enum2type[type]
+    if T <: Array
+        decode_array(io, eltype(T))
+    else
+        read(io, T)
+    end
+end
+
+function encode_record(keywords::Associative)
+    io = IOBuffer()
+    encode_record(io, keywords)
+    take!(io)
+end
+
+function encode_record(io, keywords::Associative)
+    write(io, Int32(length(keywords)))
+    for (name, value) in keywords
+        encode_string(io, String(name))
+        encode_value(io, name, value)
+    end
+end
+
+function encode_string(io, string::String)
+    write(io, Int32(sizeof(string)))
+    write(io, string)
+end
+
+function encode_shape(io, array)
+    write(io, Int32(ndims(array)))
+    for dim in size(array)
+        write(io, Int32(dim))
+    end
+end
+
+function encode_value(io, name, value)
+    T = typeof(value)
+    if T in typelist
+        write(io, Int32(type2enum[T]))
+        T == String ? encode_string(io, value) : write(io, value)
+    elseif T <: Array && eltype(T) in typelist
+        write(io, Int32(type2enum[eltype(T)]) + Int32(TpArrayBool))
+        encode_shape(io, value)
+        if eltype(T) == String
+            foreach(string -> encode_string(io, string), value)
+        else
+            write(io, value)
+        end
+    elseif T <: Associative
+        write(io, Int32(TpRecord))
+        encode_record(io, value)
+    elseif T == Table
+        write(io, Int32(TpTable))
+        encode_string(io, "Table: " * value.path)
+    else
+        keyword_set_type_error(name, T)
+    end
+end
@@ -0,0 +1,187 @@
+# Copyright (c) 2015-2017 Michael Eastwood
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+@noinline function ragged_scalar_column_error(column)
+    err("column \"$column\" is a scalar column")
+end
+
+"""
+    Tables.RaggedColumn{T, N}
+
+The contents of an array column where each cell may have a different shape. Indexing a
+`RaggedColumn` with a row number returns the `Array{T, N}` stored in that row.
+
+**Fields:**
+
+- `data` - the contents of every cell concatenated in row order
+- `shapes` - the shape of each cell (`N × Nrows`), where undefined cells have a shape of zeros
+- `offsets` - the contents of row `i` are `data[offsets[i]+1:offsets[i+1]]`
+
+**Usage:**
+
+```jldoctest
+julia> table = Tables.create("/tmp/my-table.ms")
+       Tables.add_rows!(table, 2)
+       table["CHAN_FREQ"] = Tables.RaggedColumn([[1e8, 2e8], [3e8, 4e8, 5e8]])
+       column = Tables.read_ragged(table, "CHAN_FREQ")
+       column[2]
+3-element Array{Float64,1}:
+ 3.0e8
+ 4.0e8
+ 5.0e8
+
+julia> Tables.delete(table)
+```
+
+**See also:** [`Tables.read_ragged`](@ref)
+"""
+struct RaggedColumn{T, N} <: AbstractVector{Array{T, N}}
+    data    :: Vector{T}
+    shapes  :: Matrix{Int}
+    offsets :: Vector{Int}
+    function RaggedColumn{T, N}(data, shapes, offsets) where {T, N}
+        size(shapes, 1) == N || throw(DimensionMismatch("expected $N dimensions"))
+        new(data, shapes, offsets)
+    end
+end
+
+function RaggedColumn(data::Vector{T}, shapes::AbstractMatrix) where T
+    shapes = convert(Matrix{Int}, shapes)
+    offsets = [0; cumsum(vec(prod(shapes, 1)))]
+    RaggedColumn{T, size(shapes, 1)}(data, shapes, offsets)
+end
+
+function RaggedColumn(cells::AbstractVector{Array{T, N}}) where {T, N}
+    shapes = Int[size(cell, dim) for dim = 1:N, cell in cells]
+    data = T[]
+    for cell in cells
+        append!(data, cell)
+    end
+    RaggedColumn(data, shapes)
+end
+
+Base.size(column::RaggedColumn) = (size(column.shapes, 2),)
+Base.IndexStyle(::Type{<:RaggedColumn}) = IndexLinear()
+
+function Base.getindex(column::RaggedColumn{T, N}, row::Int) where {T, N}
+    shape = ntuple(dim -> column.shapes[dim, row], Val{N})
+    reshape(column.data[column.offsets[row]+1:column.offsets[row+1]], shape)
+end
+
+"""
+    Tables.read_ragged(table, column)
+
+Read every cell of an array column, even if the cells have different shapes (for example the
+`DATA` column of a measurement set with spectral windows that have different numbers of
+channels). The result is a [`Tables.RaggedColumn`](@ref), which stores the contents of every cell
+in a single buffer. Use `table[column] = ragged` to write a `RaggedColumn` back to the table.
+
+**Arguments:**
+
+- `table` - the relevant table
+- `column` - the name of the array column
+"""
+function read_ragged(table::Table, column::String)
+    isopen(table) || table_closed_error()
+    if !column_exists(table, column)
+        column_missing_error(column)
+    end
+    if column_is_scalar(table, column)
+        ragged_scalar_column_error(column)
+    end
+    T, _ = column_info(table, column)
+    ndim = Ref{Cint}(0)
+    ptr = ccall((:get_column_shapes, libcasacorewrapper), Ptr{Cint},
+                (Ptr{CasaCoreTable}, Ptr{Cchar}, Ref{Cint}), table, column, ndim)
+    shapes = unsafe_wrap(Matrix{Cint}, ptr, (Int(ndim[]), num_rows(table)), true)
+    total = sum(prod(Int.(shapes), 1))
+    data = read_ragged(table, column, T, total)
+    RaggedColumn(data, shapes)
+end
+
+function Base.setindex!(table::Table, value::RaggedColumn{T, N}, column::String) where {T, N}
+    isopen(table) || table_closed_error()
+    iswritable(table) || table_readonly_error()
+    if length(value) != num_rows(table)
+        column_length_mismatch_error(length(value), num_rows(table))
+    end
+    if !column_exists(table, column)
+        add_ragged_column!(table, column, T, N)
+    end
+    T′, _ = column_info(table, column)
+    T == T′ || column_element_type_error(column)
+    column_is_scalar(table, column) && ragged_scalar_column_error(column)
+    check_ndim(table, column, N)
+    if column_is_fixed_shape(table, column)
+        _, shape = column_info(table, column)
+        cell = collect(shape[1:end-1])
+        for row = 1:length(value)
+            value.shapes[:, row] == cell || column_shape_error(column)
+        end
+    end
+    write_ragged!(table, value, column)
+end
+
+"Check to see if the column is a scalar column."
+function column_is_scalar(table::Table, column::String)
+    ccall((:column_is_scalar, libcasacorewrapper), Bool,
+          (Ptr{CasaCoreTable}, Ptr{Cchar}), table, column)
+end
+
+"Get the number of dimensions of the cells in an array column (≤ 0 if any number is allowed)."
+function column_ndim(table::Table, column::String)
+    ccall((:column_ndim, libcasacorewrapper), Cint,
+          (Ptr{CasaCoreTable}, Ptr{Cchar}), table, column)
+end
+
+function check_ndim(table, column, N)
+    ndim = column_ndim(table, column)
+    ndim > 0 && ndim != N && column_shape_error(column)
+end
+
+"Check to see if every cell of the column is defined and has the same shape."
+function column_has_uniform_shape(table::Table, column::String)
+    ccall((:column_has_uniform_shape, libcasacorewrapper), Bool,
+          (Ptr{CasaCoreTable}, Ptr{Cchar}), table, column)
+end
+
+for T in typelist
+    Tc = type2cpp[T]
+    typestr = type2str[T]
+    c_add_ragged_column = String(Symbol(:add_ragged_column_, typestr))
+    c_get_column_ragged = String(Symbol(:get_column_ragged_, typestr))
+    c_put_column_ragged = String(Symbol(:put_column_ragged_, typestr))
+
+    @eval function add_ragged_column!(table::Table, column::String, ::Type{$T}, ndim)
+        ccall(($c_add_ragged_column, libcasacorewrapper), Void,
+              (Ptr{CasaCoreTable}, Ptr{Cchar}, Cint), table, column, ndim)
+        column
+    end
+
+    @eval function read_ragged(table::Table, column::String, ::Type{$T}, total)
+        ptr = ccall(($c_get_column_ragged, libcasacorewrapper), Ptr{$Tc},
+                    (Ptr{CasaCoreTable}, Ptr{Cchar}), table, column)
+        wrap(ptr, (total,))
+    end
+
+    @eval function write_ragged!(table::Table, value::RaggedColumn{$T}, column::String)
+        shapes = convert(Matrix{Cint}, value.shapes)
+        ccall(($c_put_column_ragged, libcasacorewrapper), Void,
+              (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{$Tc}, Ptr{Cint}, Cint),
+              table, column, value.data, shapes, size(shapes, 1))
+        written!(table, payload_bytes(value.data))
+        value
+    end
+end
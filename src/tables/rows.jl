@@ -82,6 +82,7 @@ function add_rows!(table::Table, number::Integer)
     iswritable(table) || table_readonly_error()
     ccall((:add_rows, libcasacorewrapper), Void,
           (Ptr{CasaCoreTable}, Cuint), table, number)
+    written!(table, 0)
     number
 end
 
@@ -128,6 +129,7 @@ function remove_rows!(table::Table, rows)
     ccall((:remove_rows, libcasacorewrapper), Void,
           (Ptr{CasaCoreTable}, Ptr{Cuint}, Csize_t),
           table, c_rows, length(c_rows))
+    written!(table, 0)
     rows
 end
 
@@ -22,6 +22,11 @@ struct CasaCoreTable end
 
 @enum TableStatus closed=0 readonly=1 readwrite=5
 
+# This enum must mirror `casacore::TableLock::LockOption`.
+@enum(LockOption,
+      PermanentLocking, PermanentLockingWait, AutoLocking, UserLocking,
+      AutoNoReadLocking, UserNoReadLocking, NoLocking, DefaultLocking)
+
 """
     mutable struct Table
 
@@ -70,8 +75,9 @@ mutable struct Table
     path   :: String
     status :: TableStatus
     ptr    :: Ptr{CasaCoreTable}
-    function Table(path, status, ptr)
-        table = new(path, status, ptr)
+    cached :: Bool # true if the table was obtained from the table cache
+    function Table(path, status, ptr, cached=false)
+        table = new(path, status, ptr, cached)
         finalizer(table, close)
         table
     end
@@ -111,7 +117,7 @@ function create(path)
 end
 
 """
-    open(path; write=false)
+    open(path; write=false, lock=Tables.DefaultLocking, inspection_interval=5.0, cached=false)
 
 Open the CasaCore table at the given path.
 
@@ -122,6 +128,26 @@ Open the CasaCore table at the given path.
 **Keyword Arguments:**
 
 - `write` - if `false` (the default) the table will be opened read-only
+- `lock` - the locking mode used for the table (see below)
+- `inspection_interval` - with `Tables.AutoLocking` this is the number of seconds between checks
+  for other processes waiting to acquire the lock
+- `cached` - if `true` the table is obtained from (or added to) the table cache (see
+  [`Tables.clear_cache!`](@ref))
+
+**Locking Modes:**
+
+- `Tables.DefaultLocking` - use CasaCore's default (usually `Tables.AutoLocking`)
+- `Tables.AutoLocking` - locks are acquired and released automatically as needed
+- `Tables.AutoNoReadLocking` - as above, but no lock is acquired for reading
+- `Tables.UserLocking` - locks must be acquired explicitly with [`Tables.lock`](@ref)
+- `Tables.UserNoReadLocking` - as above, but no lock is needed for reading
+- `Tables.PermanentLocking` - a lock is held for as long as the table is open
+- `Tables.PermanentLockingWait` - as above, but wait for the lock rather than failing
+- `Tables.NoLocking` - no locking at all (only safe if no other process writes to the table)
+
+Many processes reading the same table will spend a lot of time contending for the lock file with
+`Tables.AutoLocking`. In this case it is much faster to open the table with
+`Tables.AutoNoReadLocking` or `Tables.NoLocking`.
 
 **Usage:**
 
@@ -135,45 +161,68 @@ Table: /tmp/my-table.ms (read-only)
 julia> table″ = Tables.open("/tmp/my-table.ms", write=true)
 Table: /tmp/my-table.ms (read/write)
 
+julia> table‴ = Tables.open("/tmp/my-table.ms", lock=Tables.NoLocking)
+Table: /tmp/my-table.ms (read-only)
+
 julia> Tables.close(table′)
        Tables.close(table″)
+       Tables.close(table‴)
        Tables.delete(table)
 ```
 
-**See also:** [`Tables.create`](@ref), [`Tables.close`](@ref), [`Tables.delete`](@ref)
+**See also:** [`Tables.create`](@ref), [`Tables.close`](@ref), [`Tables.delete`](@ref),
+[`Tables.lock`](@ref), [`Tables.unlock`](@ref)
 """
-function open(path; write=false)
+function open(path; write=false, lock::LockOption=DefaultLocking, inspection_interval=5.0,
+              cached=false)
     path = table_fix_path(path)
     if !isdir(path)
         table_does_not_exist_error()
     end
     mode = write ? readwrite : readonly
-    ptr = ccall((:new_table_open, libcasacorewrapper), Ptr{CasaCoreTable},
-                (Ptr{Cchar}, Cint), path, mode)
-    Table(path, mode, ptr)
+    ptr = open_table_ptr(path, mode, lock, inspection_interval, cached)
+    Table(path, mode, ptr, cached)
 end
 
-function open(table::Table; write=false)
+function open(table::Table; write=false, lock::LockOption=DefaultLocking, inspection_interval=5.0,
+              cached=false)
     if !isopen(table)
         path = table_fix_path(table.path)
         if !isdir(path)
             table_does_not_exist_error()
         end
         mode = write ? readwrite : readonly
-        ptr = ccall((:new_table_open, libcasacorewrapper), Ptr{CasaCoreTable},
-                    (Ptr{Cchar}, Cint), path, mode)
+        ptr = open_table_ptr(path, mode, lock, inspection_interval, cached)
         table.path   = path
         table.status = mode
         table.ptr    = ptr
+        table.cached = cached
     end
     table
 end
 
+function open_table_ptr(path, mode, lock, inspection_interval, cached)
+    if cached
+        return ccall((:new_table_open_cached, libcasacorewrapper), Ptr{CasaCoreTable},
+                     (Ptr{Cchar}, Cint, Cint, Cdouble), path, mode, lock, inspection_interval)
+    elseif lock == DefaultLocking
+        return ccall((:new_table_open, libcasacorewrapper), Ptr{CasaCoreTable},
+                     (Ptr{Cchar}, Cint), path, mode)
+    else
+        return ccall((:new_table_open_with_lock, libcasacorewrapper), Ptr{CasaCoreTable},
+                     (Ptr{Cchar}, Cint, Cint, Cdouble), path, mode, lock, inspection_interval)
+    end
+end
+
 """
     close(table)
 
 Close the given CasaCore table.
 
+If the table was opened with `cached=true` the table cache keeps the table itself open (see
+[`Tables.clear_cache!`](@ref)), so any changes are flushed to disk and the lock on the table is
+released instead.
+
 **Arguments:**
 
 - `table` - the table to be closed
@@ -194,8 +243,14 @@ julia> Tables.delete(table)
 """
 function close(table::Table)
     if isopen(table)
-        ccall((:delete_table, libcasacorewrapper), Void,
-              (Ptr{CasaCoreTable},), table)
+        stop_flush_timer!(table)
+        if table.cached
+            ccall((:delete_cached_table, libcasacorewrapper), Void,
+                  (Ptr{CasaCoreTable},), table)
+        else
+            ccall((:delete_table, libcasacorewrapper), Void,
+                  (Ptr{CasaCoreTable},), table)
+        end
         table.status = closed
     end
 end
@@ -222,9 +277,544 @@ julia> Tables.delete(table)
 """
 function delete(table::Table)
     close(table)
+    invalidate_cache!(table.path)
     rm(table.path, recursive=true, force=true)
 end
 
+"""
+    Tables.clear_cache!()
+
+Close every table held by the table cache.
+
+Opening a table requires reading the table description and the header of every storage manager
+from disk. When the same tables are opened over and over again (for example by a service answering
+many small queries) this can dominate the run time. Tables opened with `Tables.open(path,
+cached=true)` are therefore kept open by a cache of the most recently used tables, and reopening
+the table with the same mode, locking option, and inspection interval is nearly free (opening it
+with a different inspection interval adds a separate entry to the cache).
+
+Cached tables remain open after being closed with [`Tables.close`](@ref). Closing a cached table
+still flushes any changes to disk and releases its lock (so other processes can see the changes and
+write to the table), but the files stay open until the table is evicted from the cache by
+[`Tables.invalidate_cache!`](@ref), [`Tables.clear_cache!`](@ref), or by opening other tables once
+the cache is full. Note that the lock is shared with every other handle to the same table in this
+process, so closing a cached table also releases a lock acquired through another handle. Closing a
+table that was not obtained from the cache never releases the lock of another handle. A table
+opened with `Tables.NoLocking` (or a permanent lock) will not see changes made by other processes
+while it is in the cache, so use [`Tables.invalidate_cache!`](@ref) when a table is known to have
+changed.
+
+**Usage:**
+
+```jldoctest
+julia> table = Tables.create("/tmp/my-table.ms")
+       Tables.close(table)
+       table = Tables.open("/tmp/my-table.ms", cached=true)
+       Tables.close(table)
+       table = Tables.open("/tmp/my-table.ms", cached=true) # does not reopen the table
+       Tables.close(table)
+       Tables.cache_size()
+1
+
+julia> Tables.clear_cache!()
+       Tables.cache_size()
+0
+
+julia> Tables.delete(table)
+```
+
+**See also:** [`Tables.invalidate_cache!`](@ref), [`Tables.cache_capacity!`](@ref)
+"""
+function clear_cache!()
+    ccall((:table_cache_clear, libcasacorewrapper), Void, ())
+end
+
+"""
+    Tables.invalidate_cache!(path)
+
+Remove the table at the given path from the table cache (for every mode and locking option).
+The table will be reopened from disk the next time it is opened with `cached=true`.
+
+**See also:** [`Tables.clear_cache!`](@ref)
+"""
+function invalidate_cache!(path)
+    path = table_fix_path(path)
+    ccall((:table_cache_invalidate, libcasacorewrapper), Void, (Ptr{Cchar},), path)
+end
+
+"""
+    Tables.cache_capacity!(capacity)
+
+Set the maximum number of tables held by the table cache (16 by default). The least recently used
+tables are closed when the cache is full.
+
+**See also:** [`Tables.clear_cache!`](@ref), [`Tables.cache_size`](@ref)
+"""
+function cache_capacity!(capacity::Integer)
+    capacity ≥ 0 || throw(ArgumentError("the cache capacity must be non-negative"))
+    ccall((:table_cache_resize, libcasacorewrapper), Void, (Cint,), capacity)
+end
+
+"""
+    Tables.cache_size()
+
+Returns the number of tables currently held by the table cache.
+
+**See also:** [`Tables.clear_cache!`](@ref), [`Tables.cache_capacity!`](@ref)
+"""
+function cache_size()
+    ccall((:table_cache_size, libcasacorewrapper), Cint, ()) |> Int
+end
+
+@noinline table_lock_error() = err("Could not acquire a lock on the table.")
+
+"""
+    Tables.lock(table; write=true, attempts=5)
+
+Acquire a lock on the given table. This is required before accessing a table that was opened with
+`Tables.UserLocking`. Throws a `CasaCoreTablesError` if the lock is not obtained after the given
+number of attempts (each attempt waits for approximately one second).
+
+**Arguments:**
+
+- `table` - the table to lock
+
+**Keyword Arguments:**
+
+- `write` - if `true` (the default) a write lock is acquired, otherwise a read lock is acquired
+- `attempts` - the number of attempts to make before giving up (zero means wait forever)
+
+**Usage:**
+
+```jldoctest
+julia> table = Tables.create("/tmp/my-table.ms")
+       Tables.close(table)
+       table = Tables.open("/tmp/my-table.ms", write=true, lock=Tables.UserLocking)
+       Tables.lock(table)
+       Tables.haslock(table)
+true
+
+julia> Tables.unlock(table)
+       Tables.haslock(table)
+false
+
+julia> Tables.delete(table)
+```
+
+**See also:** [`Tables.unlock`](@ref), [`Tables.haslock`](@ref)
+"""
+function lock(table::Table; write::Bool=true, attempts::Integer=5)
+    isopen(table) || table_closed_error()
+    success = ccall((:lock_table, libcasacorewrapper), Bool,
+                    (Ptr{CasaCoreTable}, Bool, Cint), table, write, attempts)
+    success || table_lock_error()
+    table
+end
+
+"""
+    Tables.unlock(table)
+
+Release any locks held on the given table. Any pending changes are flushed to disk first.
+
+**See also:** [`Tables.lock`](@ref), [`Tables.haslock`](@ref)
+"""
+function unlock(table::Table)
+    isopen(table) || table_closed_error()
+    ccall((:unlock_table, libcasacorewrapper), Void, (Ptr{CasaCoreTable},), table)
+    table
+end
+
+"""
+    Tables.haslock(table; write=true)
+
+Returns `true` if a write lock (or a read lock if `write=false`) is currently held on the table.
+
+**See also:** [`Tables.lock`](@ref), [`Tables.unlock`](@ref)
+"""
+function haslock(table::Table; write::Bool=true)
+    isopen(table) || table_closed_error()
+    ccall((:table_has_lock, libcasacorewrapper), Bool,
+          (Ptr{CasaCoreTable}, Bool), table, write)
+end
+
+"""
+    Tables.flush!(table; fsync=false, recursive=true)
+
+Write any changes to the table that are still held in memory to disk. Otherwise changes are only
+guaranteed to reach the disk when the table is closed.
+
+**Arguments:**
+
+- `table` - the table to flush
+
+**Keyword Arguments:**
+
+- `fsync` - if `true`, also ask the operating system to commit the files to the disk, so that the
+  changes survive a crash of the whole machine (and not just the Julia process)
+- `recursive` - if `true`, also flush the subtables
+
+**See also:** [`Tables.auto_flush!`](@ref), [`Tables.close`](@ref)
+"""
+function flush!(table::Table; fsync::Bool=false, recursive::Bool=true)
+    isopen(table) || table_closed_error()
+    ccall((:flush_table, libcasacorewrapper), Void,
+          (Ptr{CasaCoreTable}, Bool, Bool), table, fsync, recursive)
+    policy = get(flush_policies, table, nothing)
+    if policy !== nothing
+        policy.pending = 0
+        policy.last_flush = time()
+    end
+    table
+end
+
+mutable struct FlushPolicy
+    bytes   :: Float64
+    seconds :: Float64
+    fsync   :: Bool
+    pending :: Int
+    last_flush :: Float64
+    timer   :: Union{Timer, Void} # flushes pending writes if nothing else is written
+end
+
+const flush_policies = WeakKeyDict{Table, FlushPolicy}()
+
+# The timer only holds a weak reference to the table so that it doesn't keep the table alive.
+function start_flush_timer!(table::Table, policy::FlushPolicy)
+    ref = WeakRef(table)
+    delay = max(policy.last_flush + policy.seconds - time(), 0.0)
+    policy.timer = Timer(timer -> timed_flush(ref, policy), delay)
+end
+
+function timed_flush(ref::WeakRef, policy::FlushPolicy)
+    policy.timer = nothing
+    table = ref.value
+    if (table !== nothing && isopen(table) && policy.pending > 0 &&
+            get(flush_policies, table, nothing) === policy)
+        flush!(table, fsync=policy.fsync)
+    end
+end
+
+function stop_flush_timer!(table::Table)
+    isempty(flush_policies) && return
+    policy = get(flush_policies, table, nothing)
+    if policy !== nothing && policy.timer !== nothing
+        Base.close(policy.timer)
+        policy.timer = nothing
+    end
+end
+
+"""
+    Tables.auto_flush!(table; bytes=Inf, seconds=Inf, fsync=false)
+
+Flush the table automatically once enough data has been written to it, or once enough time has
+passed since the last flush. Writes are held in memory by CasaCore between flushes, so this bounds
+the amount of data that can be lost in a crash without paying for a flush on every write.
+
+The `bytes` threshold is checked whenever data is written to the table through this package.
+Writes to cells, columns, and keywords count the size of the values that were written, and adding
+or removing rows counts as a write of zero bytes. Unflushed writes are flushed once `seconds` have
+passed since the last flush, even if nothing else is written to the table (this is done by a timer,
+so it happens the next time Julia is idle or waiting on I/O). Calling this function with neither
+threshold disables automatic flushing, and closing the table cancels any pending timer.
+
+**Arguments:**
+
+- `table` - the table to flush automatically
+
+**Keyword Arguments:**
+
+- `bytes` - flush after this many bytes have been written since the last flush
+- `seconds` - flush any unflushed writes this many seconds after the last flush
+- `fsync` - passed to [`Tables.flush!`](@ref) for each automatic flush
+
+**Usage:**
+
+```julia
+table = Tables.open("/data/ingest.ms", write=true)
+Tables.auto_flush!(table, bytes=256*1024^2, seconds=30)
+```
+
+**See also:** [`Tables.flush!`](@ref)
+"""
+function auto_flush!(table::Table; bytes::Real=Inf, seconds::Real=Inf, fsync::Bool=false)
+    isopen(table) || table_closed_error()
+    stop_flush_timer!(table)
+    if isinf(bytes) && isinf(seconds)
+        delete!(flush_policies, table)
+    else
+        flush_policies[table] = FlushPolicy(bytes, seconds, fsync, 0, time(), nothing)
+    end
+    table
+end
+
+# The number of writes made through this package to the table at each (absolute) path. Anything
+# derived from the contents of a table (such as the metadata of a measurement set) can compare
+# these counts to notice changes made by this process straight away. Changes made by other
+# processes are only visible through the modification time of the table files.
+const modification_counts = Dict{String, Int}()
+
+modification_key(path) = String(rstrip(abspath(path), '/'))
+modification_count(path) = get(modification_counts, modification_key(path), 0)
+
+# Called after every write so that the automatic flushing policy can be applied.
+function written!(table::Table, bytes)
+    key = modification_key(table.path)
+    modification_counts[key] = get(modification_counts, key, 0) + 1
+    isempty(flush_policies) && return
+    policy = get(flush_policies, table, nothing)
+    policy === nothing && return
+    policy.pending += bytes
+    if policy.pending ≥ policy.bytes || time() - policy.last_flush ≥ policy.seconds
+        flush!(table, fsync=policy.fsync)
+    elseif policy.timer === nothing && isfinite(policy.seconds)
+        start_flush_timer!(table, policy)
+    end
+    nothing
+end
+
+payload_bytes(value) = sizeof(value)
+payload_bytes(value::BitArray) = sizeof(value.chunks)
+payload_bytes(value::Array{String}) = mapreduce(sizeof, +, 0, value)
+
+@noinline no_columns_error() = err("At least one column must be copied.")
+
+@noinline function storage_manager_error(storage_manager)
+    err("unknown storage manager option: $storage_manager")
+end
+
+"""
+    Tables.deep_copy(table, path; columns=nothing, rows=nothing, storage_manager=:preserve)
+
+Copy the given table (and all of its subtables) to a new path. The new table is opened for
+writing and returned.
+
+**Arguments:**
+
+- `table` - the table to be copied
+- `path` - the path where the copy will be created
+
+**Keyword Arguments:**
+
+- `columns` - a list of the columns to copy (all of the columns are copied by default, and an
+  empty list is an error)
+- `rows` - the rows to copy (all of the rows are copied by default, and an empty list creates a
+  table with the same columns but no rows)
+- `storage_manager` - if `:preserve` (the default) the copied columns use the same storage
+  managers as the original table, and if `:standard` all tiled storage managers are replaced with
+  the standard storage manager
+
+!!! note
+    The data cannot be re-tiled with a different tile shape. `storage_manager=:standard` removes
+    the tiling altogether, which can be useful when the copy will be read one row at a time.
+
+If all the columns and rows are copied without changing the storage managers, the files that make
+up the table are copied directly, which is much faster than copying the table row by row.
+
+**Usage:**
+
+```jldoctest
+julia> table = Tables.create("/tmp/my-table.ms")
+       Tables.add_rows!(table, 10)
+       table["A"] = collect(1.0:10.0)
+       table["B"] = rand(Int32, 10)
+       table′ = Tables.deep_copy(table, "/tmp/my-copy.ms", columns=["A"], rows=1:2:10)
+       Tables.num_columns(table′), Tables.num_rows(table′)
+(1, 5)
+
+julia> table′["A"]
+5-element Array{Float64,1}:
+ 1.0
+ 3.0
+ 5.0
+ 7.0
+ 9.0
+
+julia> Tables.delete(table′)
+       Tables.delete(table)
+```
+
+**See also:** [`Tables.create`](@ref), [`Tables.open`](@ref), [`Tables.delete`](@ref)
+"""
+function deep_copy(table::Table, path; columns=nothing, rows=nothing, storage_manager=:preserve)
+    isopen(table) || table_closed_error()
+    path = table_fix_path(path)
+    if isfile(path) || isdir(path)
+        table_exists_error()
+    end
+    if columns === nothing
+        c_columns = String[]
+    else
+        c_columns = collect(String, columns)
+        isempty(c_columns) && no_columns_error()
+        for column in c_columns
+            column_exists(table, column) || column_missing_error(column)
+        end
+    end
+    if rows === nothing
+        select_rows = false
+        c_rows = Cuint[]
+    else
+        select_rows = true
+        N = num_rows(table)
+        if any(rows .≤ 0) || any(rows .≥ N+1)
+            row_out_of_bounds_error(rows)
+        end
+        c_rows = collect(Cuint, rows.-1)
+    end
+    if storage_manager == :preserve
+        replace_tiled = false
+    elseif storage_manager == :standard
+        replace_tiled = true
+    else
+        storage_manager_error(storage_manager)
+    end
+    ptr = ccall((:new_table_copy, libcasacorewrapper), Ptr{CasaCoreTable},
+                (Ptr{CasaCoreTable}, Ptr{Cchar}, Ptr{Ptr{Cchar}}, Cint, Ptr{Cuint}, Csize_t, Bool,
+                 Bool),
+                table, path, c_columns, length(c_columns), c_rows, length(c_rows), select_rows,
+                replace_tiled)
+    Table(path, readwrite, ptr)
+end
+
+@noinline table_description_mismatch_error() = err("Tables must have matching columns.")
+@noinline no_tables_error() = err("At least one table is required.")
+@noinline missing_subtable_error(name) = err("Every table must have the $name subtable.")
+
+"""
+    Tables.concatenate(tables; subtables=String[])
+
+Virtually concatenate the given tables. The rows of the resulting table are the rows of each of
+the given tables in order, so that row 1 of the second table immediately follows the last row of
+the first table. No data is copied, and every column and cell can be accessed as for a regular
+table. The resulting table can only be written to if all of the given tables are writable.
+
+All of the tables must have the same columns (with the same element types). Array columns must
+also have the same number of dimensions, and a fixed shape column must have the same shape in
+every table (so, for example, spectral windows with different numbers of channels cannot be
+concatenated). Every table must have each of the given `subtables`.
+
+**Arguments:**
+
+- `tables` - a list of the tables to concatenate
+
+**Keyword Arguments:**
+
+- `subtables` - the names of subtables that should also be concatenated (otherwise the subtables
+  of the first table are used)
+
+**Usage:**
+
+```jldoctest
+julia> table1 = Tables.create("/tmp/my-table-1.ms")
+       table2 = Tables.create("/tmp/my-table-2.ms")
+       Tables.add_rows!(table1, 2)
+       Tables.add_rows!(table2, 3)
+       table1["TIME"] = [1.0, 2.0]
+       table2["TIME"] = [3.0, 4.0, 5.0]
+       table = Tables.concatenate([table1, table2])
+       table["TIME"]
+5-element Array{Float64,1}:
+ 1.0
+ 2.0
+ 3.0
+ 4.0
+ 5.0
+
+julia> Tables.close(table)
+       Tables.delete(table1)
+       Tables.delete(table2)
+```
+
+**See also:** [`Tables.open`](@ref)
+"""
+function concatenate(tables; subtables=String[])
+    tables = collect(Table, tables)
+    isempty(tables) && no_tables_error()
+    for table in tables
+        isopen(table) || table_closed_error()
+    end
+    c_tables = [table.ptr for table in tables]
+    c_subtables = collect(String, subtables)
+    for table in tables, subtable in c_subtables
+        keyword_exists(table, Keyword(subtable)) || missing_subtable_error(subtable)
+    end
+    ptr = ccall((:new_table_concat, libcasacorewrapper), Ptr{CasaCoreTable},
+                (Ptr{Ptr{CasaCoreTable}}, Cint, Ptr{Ptr{Cchar}}, Cint),
+                c_tables, length(c_tables), c_subtables, length(c_subtables))
+    ptr == C_NULL && table_description_mismatch_error()
+    path = ccall((:table_name, libcasacorewrapper), Ptr{Cchar},
+                 (Ptr{CasaCoreTable},), ptr) |> wrap_value
+    status = all(iswritable, tables) ? readwrite : readonly
+    Table(path, status, ptr)
+end
+
+@noinline no_sort_columns_error() = err("At least one column is required to sort the table.")
+
+@noinline function sort_column_error(column)
+    err("cannot sort on column \"$column\" (only scalar columns can be used as sort keys)")
+end
+
+"""
+    sort(table, columns; rev=false, unique=false)
+
+Sort the rows of the table. The result is a reference table: no data is copied, but the rows are
+visited in the sorted order. The sort is stable, so rows with equal keys keep their original
+order. Reading an entire column of the sorted table is efficient because the underlying table is
+read in large contiguous blocks.
+
+This is useful for processing a measurement set (which is usually stored in time order) in
+baseline order without resorting to reading one row at a time.
+
+**Arguments:**
+
+- `table` - the table to sort
+- `columns` - the name of the column to sort on, or a list of column names where the first column
+  is the primary sort key, the second column is the secondary sort key, etc.
+
+**Keyword Arguments:**
+
+- `rev` - if `true` sort in descending order (this can also be a list with one entry per column)
+- `unique` - if `true` only the first row with each distinct combination of keys is kept
+
+**Usage:**
+
+```jldoctest
+julia> table = Tables.create("/tmp/my-table.ms")
+       Tables.add_rows!(table, 4)
+       table["ANTENNA1"] = Int32[1, 0, 1, 0]
+       table["TIME"] = [1.0, 1.0, 2.0, 2.0]
+       sorted = sort(table, ["ANTENNA1", "TIME"])
+       sorted["TIME"]
+4-element Array{Float64,1}:
+ 1.0
+ 2.0
+ 1.0
+ 2.0
+
+julia> Tables.close(sorted)
+       Tables.delete(table)
+```
+"""
+function Base.sort(table::Table, columns; rev=false, unique::Bool=false)
+    isopen(table) || table_closed_error()
+    columns = columns isa AbstractString ? [String(columns)] : collect(String, columns)
+    isempty(columns) && no_sort_columns_error()
+    descending = rev isa Bool ? fill(rev, length(columns)) : collect(Bool, rev)
+    length(descending) == length(columns) ||
+        throw(ArgumentError("`rev` must have one entry per sort column"))
+    for column in columns
+        column_exists(table, column) || column_missing_error(column)
+        T, shape = column_info(table, column)
+        length(shape) == 1 || sort_column_error(column)
+    end
+    ptr = ccall((:new_table_sort, libcasacorewrapper), Ptr{CasaCoreTable},
+                (Ptr{CasaCoreTable}, Ptr{Ptr{Cchar}}, Ptr{Bool}, Cint, Bool),
+                table, columns, descending, length(columns), unique)
+    path = ccall((:table_name, libcasacorewrapper), Ptr{Cchar},
+                 (Ptr{CasaCoreTable},), ptr) |> wrap_value
+    Table(path, table.status, ptr)
+end
+
 isopen(table::Table) = table.status != closed
 iswritable(table::Table) = table.status == readwrite
 
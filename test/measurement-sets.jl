@@ -73,5 +73,261 @@
         Tables.delete(ms)
     end
 
-end
+    @testset "metadata" begin
+        path = tempname()*".ms"
+        ms = MeasurementSets.create(path)
+
+        names = ["ANT1", "ANT2", "ANT3"]
+        positions = randn(3, 3)
+        antenna = ms[kw"ANTENNA"]
+        Tables.add_rows!(antenna, 3)
+        antenna["NAME"] = names
+        antenna["POSITION"] = positions
+        Tables.close(antenna)
+
+        frequencies = [[1e8, 2e8], [3e8, 4e8, 5e8]]
+        spw = ms[kw"SPECTRAL_WINDOW"]
+        Tables.add_rows!(spw, 2)
+        spw["CHAN_FREQ", 1] = frequencies[1]
+        spw["CHAN_FREQ", 2] = frequencies[2]
+        Tables.close(spw)
+
+        direction = randn(2, 1)
+        field = ms[kw"FIELD"]
+        Tables.add_rows!(field, 1)
+        field["NAME", 1] = "Cyg A"
+        field["PHASE_DIR", 1] = direction
+        Tables.close(field)
+
+        polarization = ms[kw"POLARIZATION"]
+        Tables.add_rows!(polarization, 1)
+        polarization["CORR_TYPE", 1] = Int32[5, 6, 7, 8]
+        Tables.close(polarization)
+
+        data_description = ms[kw"DATA_DESCRIPTION"]
+        Tables.add_rows!(data_description, 2)
+        data_description["SPECTRAL_WINDOW_ID"] = Int32[1, 0]
+        data_description["POLARIZATION_ID"] = Int32[0, 0]
+        Tables.close(data_description)
+
+        metadata = MeasurementSets.metadata(ms)
+        @test metadata.antenna_names == names
+        @test metadata.antenna_positions == positions
+        @test metadata.channel_frequencies == frequencies
+        @test metadata.field_names == ["Cyg A"]
+        @test metadata.field_directions == direction
+        @test metadata.data_description_spw == [2, 1]
+        @test metadata.data_description_polarization == [1, 1]
+        @test metadata.correlation_types == [Int32[5, 6, 7, 8]]
+        @test MeasurementSets.metadata(ms) === metadata # cached
+
+        MeasurementSets.invalidate_metadata!(ms)
+        @test MeasurementSets.metadata(ms) !== metadata
+        @test MeasurementSets.metadata(ms).antenna_names == names
+
+        # changes made to a subtable by this process are picked up straight away (without relying
+        # on the modification time of the subtable, which only has a resolution of one second)
+        metadata = MeasurementSets.metadata(ms)
+        field = ms[kw"FIELD"]
+        field["NAME", 1] = "Cas A"
+        Tables.close(field)
+        @test MeasurementSets.metadata(ms) !== metadata
+        @test MeasurementSets.metadata(ms).field_names == ["Cas A"]
+        @test MeasurementSets.metadata(ms) === MeasurementSets.metadata(ms)
+        field = Tables.open(path*"/FIELD/", write=true) # a different spelling of the same path
+        field["NAME", 1] = "Cyg A"
+        Tables.close(field)
+        @test MeasurementSets.metadata(ms).field_names == ["Cyg A"]
+
+        # undefined cells are reported instead of crashing
+        spw = ms[kw"SPECTRAL_WINDOW"]
+        Tables.add_rows!(spw, 1)
+        Tables.close(spw)
+        @test_throws CasaCoreTablesError MeasurementSets.metadata(ms)
+        @test_throws CasaCoreTablesError MeasurementSets.metadata(ms) # not cached
+
+        table = Tables.create(tempname()*".ms")
+        @test_throws CasaCoreTablesError MeasurementSets.metadata(table)
+        Tables.delete(table)
+
+        Tables.close(ms)
+        @test_throws CasaCoreTablesError MeasurementSets.metadata(ms)
+        Tables.delete(ms)
+    end
+
+    @testset "visibility cube" begin
+        path = tempname()*".ms"
+        ms = MeasurementSets.create(path)
+        antenna = ms[kw"ANTENNA"]
+        Tables.add_rows!(antenna, 3)
+        Tables.close(antenna)
+
+        Tables.add_rows!(ms, 6)
+        ms["TIME"] = [2.0, 2.0, 1.0, 1.0, 1.0, 2.0]
+        ms["ANTENNA1"] = Int32[0, 2, 0, 1, 0, 0]
+        ms["ANTENNA2"] = Int32[1, 1, 0, 2, 5, 0]
+        data = complex.(randn(Float32, 4, 2, 6), randn(Float32, 4, 2, 6))
+        flag = zeros(Bool, 4, 2, 6)
+        flag[2, 1, 1] = true
+        flag[3, 2, 2] = true
+        ms["DATA"] = data
+        ms["FLAG"] = flag
+        ms["FLAG_ROW"] = [false, false, true, false, false, false]
+
+        @test MeasurementSets.visibility_cube_size(ms) == (4, 2, 6, 2)
+        @test MeasurementSets.visibility_cube_size(ms, rows=3:5) == (4, 2, 6, 1)
+
+        cube = MeasurementSets.visibility_cube(ms, flags=:ignore)
+        @test cube.times == [1.0, 2.0]
+        @test cube.skipped == 1
+        @test cube.data[:, :, 2, 2] == data[:, :, 1]
+        @test cube.data[:, :, 1, 1] == data[:, :, 3]
+        @test cube.data[:, :, 5, 1] == data[:, :, 4]
+        @test cube.data[:, :, 1, 2] == data[:, :, 6]
+        swapped = conj.(data[:, :, 2])
+        swapped[[2, 3], :] = swapped[[3, 2], :]
+        @test cube.data[:, :, 5, 2] == swapped
+        @test all(cube.data[:, :, 3, :] .== 0)
+        @test isempty(cube.mask)
+
+        cube = MeasurementSets.visibility_cube(ms, flags=:nan)
+        @test isnan(cube.data[2, 1, 2, 2])
+        @test isnan(cube.data[2, 2, 5, 2]) # swapped from the third polarization
+        @test all(isnan, cube.data[:, :, 1, 1]) # flagged row
+        @test all(isnan, cube.data[:, :, 3, :]) # missing baseline
+        @test cube.data[:, :, 5, 1] == data[:, :, 4]
+
+        cube = MeasurementSets.visibility_cube(ms, flags=:mask, threads=2)
+        @test cube.data[:, :, 2, 2] == data[:, :, 1]
+        @test cube.mask[:, :, 2, 2] == flag[:, :, 1]
+        @test cube.mask[2, 2, 5, 2] && !cube.mask[3, 2, 5, 2]
+        @test all(cube.mask[:, :, 1, 1])
+        @test all(cube.mask[:, :, 3, :])
+        @test !any(cube.mask[:, :, 5, 1])
 
+        buffer = zeros(Complex64, 4, 2, 6, 1)
+        times, skipped = MeasurementSets.visibility_cube!(buffer, ms, rows=3:5, flags=:ignore)
+        @test times == [1.0]
+        @test skipped == 1
+        @test buffer[:, :, 5, 1] == data[:, :, 4]
+
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube!(buffer, ms)
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube(ms, flags=:foo)
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube(ms, column="UVW")
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube(ms, column="MODEL_DATA")
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube(ms, rows=0:3)
+
+        # the flags must match the visibilities, but are only needed if they are applied
+        ms["FLAG", 2] = zeros(Bool, 4, 3)
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube(ms, flags=:nan)
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube(ms, flags=:mask)
+        @test MeasurementSets.visibility_cube(ms, flags=:ignore).data[:, :, 2, 2] == data[:, :, 1]
+        ms["FLAG", 2] = flag[:, :, 2]
+        Tables.remove_column!(ms, "FLAG_ROW")
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube(ms, flags=:nan)
+        @test MeasurementSets.visibility_cube_size(ms) == (4, 2, 6, 2)
+        @test MeasurementSets.visibility_cube(ms, flags=:ignore).times == [1.0, 2.0]
+        ms["FLAG_ROW"] = [false, false, true, false, false, false]
+
+        # one data description per cube
+        ms["DATA_DESC_ID", 6] = Int32(1)
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube(ms)
+        cube = MeasurementSets.visibility_cube(ms, data_description=1, flags=:ignore)
+        @test cube.times == [1.0, 2.0]
+        @test cube.data[:, :, 2, 2] == data[:, :, 1]
+        @test all(cube.data[:, :, 1, 2] .== 0)
+        cube = MeasurementSets.visibility_cube(ms, data_description=2, flags=:ignore)
+        @test cube.times == [2.0]
+        @test cube.data[:, :, 1, 1] == data[:, :, 6]
+
+        # rows with the same time and baseline
+        ms["DATA_DESC_ID", 6] = Int32(0)
+        ms["ANTENNA2", 6] = Int32(1)
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube_size(ms)
+        @test_throws CasaCoreTablesError MeasurementSets.visibility_cube(ms, threads=2)
+
+        Tables.delete(ms)
+    end
+
+    @testset "rephasing" begin
+        path = tempname()*".ms"
+        ms = MeasurementSets.create(path)
+
+        antenna = ms[kw"ANTENNA"]
+        Tables.add_rows!(antenna, 2)
+        antenna["POSITION"] = [-2.4e6 -2.4e6; -4.7e6 -4.7e6; 3.7e6 3.7e6] + randn(3, 2)
+        Tables.close(antenna)
+
+        frequencies = [50e6, 60e6, 70e6]
+        spw = ms[kw"SPECTRAL_WINDOW"]
+        Tables.add_rows!(spw, 1)
+        spw["CHAN_FREQ", 1] = frequencies
+        Tables.close(spw)
+
+        field = ms[kw"FIELD"]
+        Tables.add_rows!(field, 1)
+        field["PHASE_DIR", 1] = reshape([0.1, 0.2], 2, 1)
+        Tables.close(field)
+
+        data_description = ms[kw"DATA_DESCRIPTION"]
+        Tables.add_rows!(data_description, 1)
+        data_description["SPECTRAL_WINDOW_ID"] = Int32[0]
+        data_description["POLARIZATION_ID"] = Int32[0]
+        Tables.close(data_description)
+
+        Tables.add_rows!(ms, 4)
+        ms["TIME"] = [1.0, 1.0, 2.0, 2.0]
+        ms["FIELD_ID"] = zeros(Int32, 4)
+        ms["DATA_DESC_ID"] = zeros(Int32, 4)
+        uvw = 100randn(3, 4)
+        ms["UVW"] = uvw
+        data = complex.(randn(Float32, 2, 3, 4), randn(Float32, 2, 3, 4))
+        ms["DATA"] = data
+
+        function uvw_axes(long, lat)
+            [-sin(long)           cos(long)           0
+             -sin(lat)*cos(long) -sin(lat)*sin(long)  cos(lat)
+              cos(lat)*cos(long)  cos(lat)*sin(long)  sin(lat)]
+        end
+        @test MeasurementSets.metadata(ms).field_directions ≈ reshape([0.1, 0.2], 2, 1)
+        MeasurementSets.rephase!(ms, Direction(dir"J2000", 0.3u"rad", -0.1u"rad"))
+        @test MeasurementSets.metadata(ms).field_directions ≈ reshape([0.3, -0.1], 2, 1)
+        expected_uvw = uvw_axes(0.3, -0.1) * uvw_axes(0.1, 0.2)' * uvw
+        @test ms["UVW"] ≈ expected_uvw
+        output = ms["DATA"]
+        for row = 1:4, chan = 1:3
+            Δw = expected_uvw[3, row] - uvw[3, row]
+            phasor = exp(-2π*im*Δw*frequencies[chan]/299792458.0)
+            for pol = 1:2
+                @test output[pol, chan, row] ≈ data[pol, chan, row]*phasor rtol=1e-5
+            end
+        end
+        field = ms[kw"FIELD"]
+        @test field["PHASE_DIR", 1] ≈ reshape([0.3, -0.1], 2, 1)
+        Tables.close(field)
+
+        MeasurementSets.rephase!(ms, Direction(dir"J2000", 0.1u"rad", 0.2u"rad"))
+        @test ms["UVW"] ≈ uvw
+        output = ms["DATA"]
+        for idx in eachindex(data)
+            @test output[idx] ≈ data[idx] rtol=1e-5
+        end
+
+        # a bad row is caught before anything is written
+        ms["FIELD_ID", 4] = Int32(5)
+        before = ms["UVW"]
+        @test_throws CasaCoreTablesError MeasurementSets.rephase!(ms, Direction(dir"J2000"))
+        @test ms["UVW"] == before
+        @test ms["DATA"] == output
+        ms["FIELD_ID", 4] = Int32(0)
+
+        @test_throws CasaCoreTablesError MeasurementSets.rephase!(ms, Direction(dir"J2000"),
+                                                                  columns=["MODEL_DATA"])
+        Tables.close(ms)
+        @test_throws CasaCoreTablesError MeasurementSets.rephase!(ms, Direction(dir"J2000"))
+        ms = Tables.open(path)
+        @test_throws CasaCoreTablesError MeasurementSets.rephase!(ms, Direction(dir"J2000"))
+        Tables.delete(ms)
+    end
+
+end
@@ -71,6 +71,47 @@
         @test sexagesimal(sexagesimal("+0h34m56.78s"),hours=true,digits=2)  == "0h34m56.78s"
         @test sexagesimal(20.5u"°") == "+20d30m00s"
         @test sexagesimal(1.23u"rad") == "+70d28m26s"
+
+        strings = ["12h34m56.78s", "-0h34m56.78s", "12.34h", "12d34m56.78s", "-12d34.56m",
+                   "+12.34d", "12:34:56.78", "00:34:56.78", " 12:34 ", "+12.34.56.78", "-0.34.56"]
+        expected = [sexagesimal("12h34m56.78s"), sexagesimal("-0h34m56.78s"),
+                    sexagesimal("12.34h"), sexagesimal("12d34m56.78s"),
+                    sexagesimal("-12d34.56m"), sexagesimal("+12.34d"),
+                    sexagesimal("12h34m56.78s"), sexagesimal("0h34m56.78s"),
+                    sexagesimal("12h34m"), sexagesimal("+12d34m56.78s"),
+                    sexagesimal("-0d34m56s")]
+        @test sexagesimal(strings) ≈ expected
+        @test sexagesimal(strings[1:6]) == expected[1:6] # identical to the scalar parser
+        @test sexagesimal(reshape(strings[1:6], 2, 3)) == reshape(expected[1:6], 2, 3)
+        @test_throws CasaCoreMeasuresError sexagesimal(["12h", "12x", "12.34", ""])
+        parsed = sexagesimal(["12h", "12x", "12.34", ""], strict=false)
+        @test parsed[1] ≈ π/12*12
+        @test all(isnan, parsed[2:end])
+        @test sexagesimal([".5h", "12h.5m", ".5d"]) ==
+            [sexagesimal(".5h"), sexagesimal("12h.5m"), sexagesimal(".5d")]
+        # the colon separated format is only for (unsigned) hours
+        parsed = sexagesimal(["-30:00:00", "+1:00", "24:00:00", "12:60", "12:30:60", "23:59:59.9"],
+                             strict=false)
+        @test all(isnan, parsed[1:5])
+        @test parsed[6] ≈ sexagesimal("23h59m59.9s")
+        @test_throws CasaCoreMeasuresError sexagesimal(["-30:00:00"])
+
+        angles = [sexagesimal("12d34m56.78s"), sexagesimal("-12d34m56.78s"), 0.0, 1.23, -1e-9]
+        for hours in (false, true), digits in (0, 2, 5)
+            @test sexagesimal(angles, hours=hours, digits=digits) ==
+                [sexagesimal(angle, hours=hours, digits=digits) for angle in angles]
+        end
+        @test sexagesimal([20.5u"°", 1.23u"rad"]) == ["+20d30m00s", "+70d28m26s"]
+        @test_throws CasaCoreMeasuresError sexagesimal([NaN])
+    end
+
+    @testset "warmup" begin
+        report = Measures.warmup!()
+        @test report.leap_seconds
+        @test report.observatories
+        @test report.conversions
+        @test contains(repr(report), "leap_seconds = true")
+        @test Measures.warmup!(date=DateTime(2015, 12, 9)).leap_seconds
     end
 
     @testset "epochs" begin
@@ -241,6 +282,112 @@
         @test x_position + y_position - z_position == Position(pos"ITRF", 2, 2, -2)
     end
 
+    @testset "batches" begin
+        frame = ReferenceFrame()
+        set!(frame, observatory("OVRO_MMA"))
+        set!(frame, Epoch(epoch"UTC", 50237.29u"d"))
+
+        directions = DirectionBatch(dir"J2000", randn(10), randn(10), randn(10))
+        @test length(directions) == 10
+        @test all(norm(direction) ≈ 1 for direction in directions)
+        @test DirectionBatch(collect(directions)) == directions
+        strings = DirectionBatch(dir"J2000", ["12h00m", "0h00m"], ["45d00m", "0d00m"])
+        @test strings[1] ≈ Direction(dir"J2000", "12h00m", "45d00m")
+        @test strings[2] ≈ Direction(dir"J2000", "0h00m", "0d00m")
+        @test DirectionBatch(dir"J2000", [180u"°"], [45u"°"])[1] ≈
+            Direction(dir"J2000", "12h00m", "45d00m")
+
+        azel = measure(frame, directions, dir"AZEL")
+        @test azel.sys === dir"AZEL"
+        @test all(azel[idx] ≈ measure(frame, directions[idx], dir"AZEL") for idx = 1:10)
+
+        positions = PositionBatch(pos"WGS84", 6.4e6 .+ randn(10), randn(10), randn(10))
+        itrf = measure(frame, positions, pos"ITRF")
+        @test itrf.sys === pos"ITRF"
+        @test all(itrf[idx] ≈ measure(frame, positions[idx], pos"ITRF") for idx = 1:10)
+
+        baselines = BaselineBatch(baseline"ITRF", randn(10), randn(10), randn(10))
+        j2000 = measure(frame, baselines, baseline"J2000")
+        @test j2000.sys === baseline"J2000"
+        @test all(j2000[idx] ≈ measure(frame, baselines[idx], baseline"J2000") for idx = 1:10)
+
+        x = Direction(dir"J2000", 1, 0, 0)
+        others = DirectionBatch(dir"J2000", randn(10), randn(10), randn(10))
+        products = dot(directions, others)
+        crosses  = cross(directions, others)
+        angles   = Measures.angle_between(directions, x)
+        R = Measures.RotationMatrix(x, directions[1])
+        rotated  = R*directions
+        for idx = 1:10
+            @test products[idx] ≈ dot(directions[idx], others[idx])
+            @test crosses[idx]  ≈ cross(directions[idx], others[idx])
+            @test angles[idx]   ≈ Measures.angle_between(directions[idx], x)
+            @test rotated[idx]  ≈ R*directions[idx]
+        end
+        @test dot(x, directions) ≈ dot(directions, x)
+        @test cross(x, directions)[2] ≈ cross(x, directions[2])
+
+        directions[1] = x
+        @test directions[1] == x
+        @test_throws CasaCoreMeasuresError directions[1] = Direction(dir"AZEL")
+        @test_throws CasaCoreMeasuresError dot(directions, azel)
+        @test_throws CasaCoreMeasuresError DirectionBatch([x, Direction(dir"AZEL")])
+        @test_throws DimensionMismatch DirectionBatch(dir"J2000", randn(2), randn(3), randn(2))
+        short = DirectionBatch(dir"J2000", randn(5), randn(5), randn(5))
+        @test_throws DimensionMismatch dot(directions, short)
+    end
+
+    @testset "epoch batches" begin
+        frame = ReferenceFrame()
+        times = 57365.5*24*60*60 .+ repeat([0.0, 10.0, 5.0], inner=4)
+        tai = measure(frame, epoch"UTC", times, epoch"TAI")
+        @test isapprox(tai - times, fill(36.0, length(times)), atol=1e-6)
+        epochs = measure(frame, [Epoch(epoch"UTC", time) for time in times], epoch"TAI")
+        @test epochs == [Epoch(epoch"TAI", time) for time in tai]
+
+        @test_throws CasaCoreMeasuresError measure(frame, epoch"UTC", times, epoch"LAST")
+        set!(frame, observatory("OVRO_MMA"))
+        lst = measure(frame, epoch"UTC", times, epoch"LAST")
+        @test lst[1:4] == fill(lst[1], 4)
+        @test lst[5] != lst[1]
+        output = copy(times)
+        @test measure!(output, frame, epoch"UTC", output, epoch"LAST") === output
+        @test output == lst
+
+        @test_throws DimensionMismatch measure!(zeros(2), frame, epoch"UTC", times, epoch"TAI")
+        @test_throws CasaCoreMeasuresError measure(frame, epoch"UTC", [times; NaN], epoch"TAI")
+        @test_throws CasaCoreMeasuresError measure(frame, epoch"UTC", [Inf], epoch"TAI")
+        @test_throws CasaCoreMeasuresError measure(frame, [Epoch(epoch"UTC", 0.0),
+                                                           Epoch(epoch"TAI", 0.0)], epoch"TDB")
+    end
+
+    @testset "fast conversions" begin
+        frame = ReferenceFrame()
+        set!(frame, observatory("OVRO_MMA"))
+        start = Epoch(epoch"UTC", 50237.0u"d")
+        stop  = Epoch(epoch"UTC", 50237.1u"d")
+        converter = FastConverter(frame, dir"J2000", dir"AZEL", start, stop, tolerance=1e-7u"rad")
+        @test Measures.validate(converter, frame, directions=10, epochs=10) < 1e-7u"rad"
+
+        epoch = Epoch(epoch"UTC", 50237.05u"d")
+        set!(frame, epoch)
+        directions = DirectionBatch(dir"J2000", randn(10), randn(10), randn(10))
+        exact  = measure(frame, directions, dir"AZEL")
+        approx = measure(converter, directions, epoch)
+        @test approx.sys === dir"AZEL"
+        for idx = 1:10
+            @test Measures.angle_between(exact[idx], approx[idx]) < 1e-6u"rad"
+            @test measure(converter, directions[idx], epoch) ≈ approx[idx]
+        end
+
+        later = Epoch(epoch"UTC", 50238.0u"d")
+        tai = Epoch(epoch"TAI", 50237.05u"d")
+        @test_throws CasaCoreMeasuresError measure(converter, directions, later)
+        @test_throws CasaCoreMeasuresError measure(converter, directions, tai)
+        @test_throws CasaCoreMeasuresError measure(converter, Direction(dir"AZEL"), epoch)
+        @test_throws CasaCoreMeasuresError FastConverter(frame, dir"J2000", dir"AZEL", stop, start)
+    end
+
     @testset "rotations" begin
         x = Direction(dir"ITRF", randn(), randn(), randn())
         y = Direction(dir"ITRF", randn(), randn(), randn())
@@ -13,6 +13,7 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+using CasaCore
 using CasaCore.Tables
 using CasaCore.Measures
 using CasaCore.MeasurementSets
@@ -25,5 +26,6 @@ srand(123)
     include("tables.jl")
     include("measures.jl")
     include("measurement-sets.jl")
+    include("stats.jl")
 end
 
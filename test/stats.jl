@@ -0,0 +1,51 @@
+# Copyright (c) 2015-2017 Michael Eastwood
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+@testset "Statistics" begin
+    path = tempname()*".ms"
+    table = Tables.create(path)
+    Tables.add_rows!(table, 10)
+
+    CasaCore.enable_stats(false)
+    @test !CasaCore.stats_enabled()
+    CasaCore.reset_stats()
+    table["DATA"] = rand(Complex64, 4, 5, 10)
+    @test !haskey(CasaCore.stats(), "put_column_complex")
+
+    CasaCore.enable_stats()
+    @test CasaCore.stats_enabled()
+    table["DATA"] = rand(Complex64, 4, 5, 10)
+    table["DATA"]
+    table["DATA"]
+    stats = CasaCore.stats()
+    @test stats["put_column_complex"].calls == 1
+    @test stats["get_column_complex"].calls == 2
+    @test stats["get_column_complex"].bytes == 2 * 4*5*10*sizeof(Complex64)
+    @test stats["get_column_complex"].allocations == 2
+    @test stats["get_column_complex"].time_copying ≥ 0
+    @test stats["get_column_complex"].time_casacore ≥ 0
+    @test contains(repr(stats["get_column_complex"]), "2 calls")
+
+    table["NAME"] = fill("Hello, world!", 10)
+    table["NAME"]
+    stats = CasaCore.stats()
+    @test stats["get_column_string"].bytes == 10*length("Hello, world!\0") + 10*sizeof(Ptr{Void})
+    @test stats["get_column_string"].allocations == 11
+
+    CasaCore.reset_stats()
+    @test isempty(CasaCore.stats())
+    CasaCore.enable_stats(false)
+    Tables.delete(table)
+end
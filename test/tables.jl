@@ -89,6 +89,324 @@
         end
     end
 
+    @testset "locking" begin
+        path = tempname()*".ms"
+        table = Tables.create(path)
+        Tables.add_rows!(table, 10)
+        table["col"] = randn(10)
+        Tables.close(table)
+
+        for lock in (Tables.AutoLocking, Tables.AutoNoReadLocking, Tables.NoLocking,
+                     Tables.PermanentLocking, Tables.PermanentLockingWait)
+            table = Tables.open(path, lock=lock)
+            @test Tables.num_rows(table) == 10
+            Tables.close(table)
+        end
+
+        table = Tables.open(path, write=true, lock=Tables.UserLocking)
+        @test !Tables.haslock(table)
+        Tables.lock(table)
+        @test Tables.haslock(table)
+        table["col"] = ones(10)
+        Tables.unlock(table)
+        @test !Tables.haslock(table)
+        Tables.lock(table, write=false)
+        @test Tables.haslock(table, write=false)
+        @test table["col"] == ones(10)
+        Tables.unlock(table)
+        Tables.close(table)
+
+        table = Tables.open(path, lock=Tables.AutoLocking, inspection_interval=0.5)
+        Tables.close(table)
+        table = Tables.open(table, write=true, lock=Tables.NoLocking)
+        @test Tables.iswritable(table)
+        Tables.close(table)
+        @test_throws CasaCoreTablesError Tables.lock(table)
+        Tables.delete(table)
+    end
+
+    @testset "flushing" begin
+        path = tempname()*".ms"
+        table = Tables.create(path)
+        Tables.add_rows!(table, 10)
+        table["A"] = collect(1.0:10.0)
+        @test Tables.flush!(table) === table
+        @test Tables.flush!(table, fsync=true, recursive=false) === table
+
+        # the flushed data is visible to another process while the table is still open (a reader
+        # in this process would share the open table and see the data even without a flush)
+        script = "using CasaCore.Tables; table = Tables.open(\"$path\"); " *
+                 "exit(table[\"A\"] == collect(1.0:10.0) ? 0 : 1)"
+        @test success(`$(Base.julia_cmd()) -e $script`)
+
+        Tables.auto_flush!(table, bytes=1000)
+        table["A"] = randn(10)
+        @test Tables.flush_policies[table].pending == 80
+        table["B"] = rand(Int32, 10, 100) # 4000 bytes triggers a flush
+        @test Tables.flush_policies[table].pending == 0
+        table["C"] = fill("", 10)
+        table["C", 1] = "hello"
+        @test Tables.flush_policies[table].pending == 5
+        table[kw"K"] = "world"
+        @test Tables.flush_policies[table].pending == 10
+        Tables.add_rows!(table, 1)
+        @test Tables.flush_policies[table].pending == 10
+
+        Tables.auto_flush!(table, seconds=0)
+        table["A", 1] = 1.0
+        @test Tables.flush_policies[table].pending == 0
+
+        # pending writes are flushed after `seconds` even if nothing else is written
+        Tables.auto_flush!(table, seconds=0.5)
+        table["A", 1] = 2.0
+        @test Tables.flush_policies[table].pending == 8
+        sleep(2)
+        @test Tables.flush_policies[table].pending == 0
+        table["A", 1] = 3.0
+        @test Tables.flush_policies[table].timer !== nothing
+        Tables.auto_flush!(table, seconds=0.5) # cancels the previous timer
+        @test Tables.flush_policies[table].timer === nothing
+
+        Tables.auto_flush!(table)
+        @test !haskey(Tables.flush_policies, table)
+
+        Tables.close(table)
+        @test_throws CasaCoreTablesError Tables.flush!(table)
+        Tables.delete(table)
+    end
+
+    @testset "caching" begin
+        path = tempname()*".ms"
+        table = Tables.create(path)
+        Tables.add_rows!(table, 10)
+        table["col"] = randn(10)
+        Tables.close(table)
+
+        Tables.clear_cache!()
+        @test Tables.cache_size() == 0
+        table = Tables.open(path, cached=true)
+        @test Tables.cache_size() == 1
+        table′ = Tables.open(path*"/", cached=true) # same table
+        @test Tables.cache_size() == 1
+        table″ = Tables.open(path, write=true, cached=true) # different mode
+        @test Tables.cache_size() == 2
+        @test table′["col"] == table["col"]
+        table″["col"] = ones(10)
+        Tables.close(table″)
+        @test table["col"] == ones(10)
+
+        Tables.close(table)
+        Tables.close(table′)
+        @test Tables.cache_size() == 2 # still cached
+        table = Tables.open(path, cached=true)
+        @test table["col"] == ones(10)
+        Tables.close(table)
+
+        Tables.invalidate_cache!(path)
+        @test Tables.cache_size() == 0
+
+        # closing a cached table still releases its lock even though the cache keeps it open
+        table = Tables.open(path, write=true, lock=Tables.UserLocking, cached=true)
+        Tables.lock(table)
+        Tables.close(table)
+        @test Tables.cache_size() == 1
+        table = Tables.open(path, write=true, lock=Tables.UserLocking, cached=true)
+        @test !Tables.haslock(table)
+        Tables.close(table)
+        Tables.invalidate_cache!(path)
+
+        # closing a table derived from a locked table (or another handle) does not release the lock
+        table = Tables.open(path, write=true, lock=Tables.UserLocking)
+        Tables.lock(table)
+        Tables.close(sort(table, "col"))
+        Tables.close(Tables.open(path, write=true, lock=Tables.UserLocking))
+        @test Tables.haslock(table)
+        Tables.unlock(table)
+        Tables.close(table)
+
+        # the inspection interval is part of the cache key
+        Tables.close(Tables.open(path, cached=true, inspection_interval=1.0))
+        Tables.close(Tables.open(path, cached=true, inspection_interval=2.0))
+        @test Tables.cache_size() == 2
+        Tables.invalidate_cache!(path)
+
+        Tables.cache_capacity!(1)
+        path′ = tempname()*".ms"
+        Tables.close(Tables.create(path′))
+        Tables.close(Tables.open(path, cached=true))
+        Tables.close(Tables.open(path′, cached=true))
+        @test Tables.cache_size() == 1
+        Tables.cache_capacity!(16)
+        @test_throws ArgumentError Tables.cache_capacity!(-1)
+
+        Tables.delete(table)
+        Tables.delete(Tables.open(path′))
+        @test Tables.cache_size() == 0
+    end
+
+    @testset "deep copy" begin
+        path = tempname()*".ms"
+        table = Tables.create(path)
+        Tables.add_rows!(table, 10)
+        a = randn(10)
+        b = rand(Int32, 4, 10)
+        c = fill("Hello, world!", 10)
+        table["A"] = a
+        Tables.add_column!(table, "B", Int32, size(b), tile_shape=(4, 5))
+        table["B"] = b
+        table["C"] = c
+        table["A", kw"UNIT"] = "m"
+        table[kw"VERSION"] = Int32(2)
+        subtable = Tables.create("$path/SUBTABLE")
+        subtable[kw"SECRET_CODE"] = Int32(42)
+        table[kw"SUBTABLE"] = subtable
+        Tables.close(subtable)
+
+        copy = Tables.deep_copy(table, tempname()*".ms")
+        @test Tables.iswritable(copy)
+        @test Tables.num_rows(copy) == 10
+        @test Tables.num_columns(copy) == 3
+        @test copy["A"] == a
+        @test copy["B"] == b
+        @test copy["C"] == c
+        @test Tables.column_data_manager(copy, "B") == "TiledColumnStMan"
+        @test copy["A", kw"UNIT"] == "m"
+        @test copy[kw"VERSION"] == 2
+        subtable = copy[kw"SUBTABLE"]
+        @test subtable[kw"SECRET_CODE"] == 42
+        Tables.close(subtable)
+        @test_throws CasaCoreTablesError Tables.deep_copy(table, copy.path)
+        Tables.delete(copy)
+
+        copy = Tables.deep_copy(table, tempname()*".ms", columns=["A", "C"], rows=[2, 4, 9])
+        @test Tables.num_rows(copy) == 3
+        @test Tables.num_columns(copy) == 2
+        @test !Tables.column_exists(copy, "B")
+        @test copy["A"] == a[[2, 4, 9]]
+        @test copy["C"] == c[[2, 4, 9]]
+        Tables.delete(copy)
+
+        copy = Tables.deep_copy(table, tempname()*".ms", rows=1:5, storage_manager=:standard)
+        @test copy["A"] == a[1:5]
+        @test copy["B"] == b[:, 1:5]
+        @test Tables.column_data_manager(table, "B") == "TiledColumnStMan"
+        @test !startswith(Tables.column_data_manager(copy, "B"), "Tiled")
+        Tables.delete(copy)
+
+        copy = Tables.deep_copy(table, tempname()*".ms", rows=Int[])
+        @test Tables.num_rows(copy) == 0
+        @test Tables.num_columns(copy) == 3
+        Tables.delete(copy)
+
+        @test_throws CasaCoreTablesError Tables.deep_copy(table, tempname()*".ms", columns=["D"])
+        @test_throws CasaCoreTablesError Tables.deep_copy(table, tempname()*".ms",
+                                                          columns=String[])
+        @test_throws CasaCoreTablesError Tables.deep_copy(table, tempname()*".ms", rows=0:2)
+        @test_throws CasaCoreTablesError Tables.deep_copy(table, tempname()*".ms", rows=[11])
+        @test_throws CasaCoreTablesError Tables.deep_copy(table, tempname()*".ms",
+                                                          storage_manager=:tiled)
+        Tables.delete(table)
+    end
+
+    @testset "concatenation" begin
+        paths = [tempname()*".ms" for idx = 1:3]
+        tables = [Tables.create(path) for path in paths]
+        data = [rand(Complex64, 4, 5, 2idx) for idx = 1:3]
+        time = [randn(2idx) for idx = 1:3]
+        for idx = 1:3
+            Tables.add_rows!(tables[idx], 2idx)
+            tables[idx]["DATA"] = data[idx]
+            tables[idx]["TIME"] = time[idx]
+        end
+
+        table = Tables.concatenate(tables)
+        @test Tables.num_rows(table) == 12
+        @test Tables.num_columns(table) == 2
+        @test table["DATA"] == cat(3, data...)
+        @test table["TIME"] == vcat(time...)
+        @test table["DATA", 3] == data[2][:, :, 1]
+        @test table["TIME", 12] == time[3][6]
+        Tables.close(table)
+
+        # the concatenation should keep working after the original tables are closed
+        table = Tables.concatenate(tables[2:3])
+        Tables.close.(tables)
+        @test table["TIME"] == vcat(time[2], time[3])
+        Tables.close(table)
+
+        tables = [Tables.open(path) for path in paths]
+        @test_throws CasaCoreTablesError Tables.concatenate(Table[])
+        Tables.close(tables[3])
+        @test_throws CasaCoreTablesError Tables.concatenate(tables)
+        tables[3] = Tables.open(paths[3], write=true)
+        Tables.remove_column!(tables[3], "TIME")
+        @test_throws CasaCoreTablesError Tables.concatenate(tables)
+        tables[3]["TIME"] = time[3]
+        @test_throws CasaCoreTablesError Tables.concatenate(tables, subtables=["NOPE"])
+        Tables.remove_column!(tables[3], "DATA")
+        tables[3]["DATA"] = rand(Complex64, 4, 6, 6) # a different number of channels
+        @test_throws CasaCoreTablesError Tables.concatenate(tables)
+        Tables.delete.(tables)
+    end
+
+    @testset "sorting" begin
+        path = tempname()*".ms"
+        table = Tables.create(path)
+        Nant  = 10
+        Ntime = 20
+        Nbase = (Nant*(Nant+1))÷2
+        Tables.add_rows!(table, Nbase*Ntime)
+        ant1 = Int32[a1 for a2 = 0:Nant-1 for a1 = 0:a2]
+        ant2 = Int32[a2 for a2 = 0:Nant-1 for a1 = 0:a2]
+        time = Float64[t for t = 1:Ntime for b = 1:Nbase]
+        uvw  = randn(3, Nbase*Ntime)
+        names = fill("name", Nbase*Ntime)
+        table["ANTENNA1"] = repmat(ant1, Ntime)
+        table["ANTENNA2"] = repmat(ant2, Ntime)
+        table["TIME"] = time
+        table["UVW"] = uvw
+        table["NAME"] = names
+
+        # baseline-major order
+        perm = sortperm(collect(zip(table["ANTENNA1"], table["ANTENNA2"], time)))
+        sorted = sort(table, ["ANTENNA1", "ANTENNA2", "TIME"])
+        @test Tables.num_rows(sorted) == Nbase*Ntime
+        @test sorted["TIME"] == time[perm]
+        @test sorted["UVW"] == uvw[:, perm]
+        @test sorted["NAME"] == names[perm]
+        @test sorted["UVW", 1] == uvw[:, perm[1]]
+        Tables.close(sorted)
+
+        sorted = sort(table, "TIME", rev=true)
+        @test sorted["TIME"] == sort(time, rev=true)
+        Tables.close(sorted)
+
+        sorted = sort(table, ["TIME", "ANTENNA1"], rev=[true, false], unique=true)
+        @test Tables.num_rows(sorted) == Ntime*Nant
+        @test issorted(sorted["TIME"], rev=true)
+        Tables.close(sorted)
+
+        sorted = sort(table, "TIME", unique=true)
+        @test sorted["TIME"] == collect(1.0:Ntime)
+        Tables.close(sorted)
+
+        # ties keep their original order
+        antenna1 = table["ANTENNA1"]
+        sorted = sort(table, "ANTENNA1")
+        @test sorted["UVW"] == uvw[:, sortperm(antenna1, alg=MergeSort)]
+        Tables.close(sorted)
+        sorted = sort(table, "ANTENNA1", unique=true)
+        @test sorted["UVW"] == uvw[:, [findfirst(antenna1, a) for a = 0:Nant-1]]
+        Tables.close(sorted)
+
+        @test_throws CasaCoreTablesError sort(table, "UVW") # array column
+        @test_throws CasaCoreTablesError sort(table, "TMIE") # typo
+        @test_throws ArgumentError sort(table, ["TIME", "ANTENNA1"], rev=[true])
+        @test_throws CasaCoreTablesError sort(table, String[])
+
+        Tables.delete(table)
+    end
+
     @testset "basic rows" begin
         path = tempname()*".ms"
         table = Tables.create(path)
@@ -131,6 +449,16 @@
         @test_throws CasaCoreTablesError Tables.add_column!(table, "test", Float64, (11,))
         @test_throws CasaCoreTablesError Tables.add_column!(table, "test", Float64, (10, 11))
 
+        Tables.add_column!(table, "tiled", Float64, (4, 10), tile_shape=(4, 5))
+        @test Tables.column_info(table, "tiled") == (Float64, (4, 10))
+        @test Tables.column_data_manager(table, "tiled") == "TiledColumnStMan"
+        Tables.remove_column!(table, "tiled")
+        @test_throws CasaCoreTablesError Tables.add_column!(table, "test", Float64, (4, 10),
+                                                            tile_shape=(4,))
+        @test_throws CasaCoreTablesError Tables.add_column!(table, "test", String, (4, 10),
+                                                            tile_shape=(4, 5))
+        @test_throws CasaCoreTablesError Tables.column_data_manager(table, "test")
+
         names = ("bools", "ints", "floats", "doubles", "complex", "strings")
         types = (Bool, Int32, Float32, Float64, Complex64, String)
         types_nostring = types[1:end-1]
@@ -173,6 +501,140 @@
         Tables.delete(table)
     end
 
+    @testset "bit-packed columns" begin
+        path = tempname()*".ms"
+        table = Tables.create(path)
+        Tables.add_rows!(table, 20001) # spans more than one block of rows
+
+        for shape in ((20001,), (3, 20001), (4, 3, 20001))
+            x = bitrand(shape)
+            table["flags"] = x
+            @test table["flags"] == x
+            y = Tables.read_bitarray(table, "flags")
+            @test y isa BitArray
+            @test y == x
+            table["flags"] = Array(.!x)
+            @test Tables.read_bitarray(table, "flags") == .!x
+            @test_throws CasaCoreTablesError table["flags"] = bitrand(3, 20000) # incorrect shape
+            Tables.remove_column!(table, "flags")
+        end
+
+        table["floats"] = randn(20001)
+        @test_throws CasaCoreTablesError Tables.read_bitarray(table, "floats")
+        @test_throws CasaCoreTablesError Tables.read_bitarray(table, "galfs") # typo
+
+        Tables.delete(table)
+    end
+
+    @testset "ragged columns" begin
+        path = tempname()*".ms"
+        table = Tables.create(path)
+        Tables.add_rows!(table, 3)
+
+        for T in (Bool, Int32, Float32, Float64, Complex64)
+            cells = [rand(T, 4, 2), rand(T, 4, 5), rand(T, 4, 1)]
+            table["ragged"] = Tables.RaggedColumn(cells)
+            @test !Tables.column_is_fixed_shape(table, "ragged")
+            @test_throws CasaCoreTablesError table["ragged"] # cells have different shapes
+            column = Tables.read_ragged(table, "ragged")
+            @test column isa Tables.RaggedColumn{T, 2}
+            @test length(column) == 3
+            @test collect(column) == cells
+            @test column.offsets == [0, 8, 28, 32]
+            for row = 1:3
+                @test table["ragged", row] == cells[row]
+            end
+            Tables.remove_column!(table, "ragged")
+        end
+        cells = [["a", "b"], ["c"], String[]]
+        table["ragged"] = Tables.RaggedColumn(cells)
+        @test collect(Tables.read_ragged(table, "ragged")) == cells
+        table["ragged", 3] = ["d", "e", "f"]
+        @test table["ragged", 3] == ["d", "e", "f"]
+        @test Tables.read_ragged(table, "ragged").shapes == [2 1 3]
+
+        # a ragged column with uniform shapes can still be read as a single array
+        x = randn(2, 3)
+        table["uniform"] = Tables.RaggedColumn([x[:, 1], x[:, 2], x[:, 3]])
+        @test table["uniform"] == x
+        @test collect(Tables.read_ragged(table, "uniform")) == [x[:, 1], x[:, 2], x[:, 3]]
+
+        # fixed shape columns can also be read this way
+        table["fixed"] = x
+        @test Tables.read_ragged(table, "fixed").data == vec(x)
+
+        table["scalar"] = randn(3)
+        @test_throws CasaCoreTablesError Tables.read_ragged(table, "scalar")
+        @test_throws CasaCoreTablesError Tables.read_ragged(table, "raggde") # typo
+        @test_throws CasaCoreTablesError table["ragged"] = Tables.RaggedColumn([[1.0], [2.0]])
+        @test_throws CasaCoreTablesError table["uniform"] = Tables.RaggedColumn([[1f0], [2f0], [3f0]])
+        # the number of dimensions must match, and so must the shape of a fixed shape column
+        @test_throws CasaCoreTablesError table["uniform"] = Tables.RaggedColumn([x, x, x])
+        @test_throws CasaCoreTablesError table["ragged", 1] = ["a" "b"]
+        @test_throws CasaCoreTablesError table["fixed"] = Tables.RaggedColumn([x[:, 1], x[:, 2],
+                                                                                [1.0]])
+        table["fixed"] = Tables.RaggedColumn([x[:, 3], x[:, 2], x[:, 1]])
+        @test table["fixed"] == x[:, [3, 2, 1]]
+
+        Tables.delete(table)
+    end
+
+    @testset "arrow" begin
+        path = tempname()*".ms"
+        arrow_path = tempname()*".arrow"
+        table = Tables.create(path)
+        Tables.add_rows!(table, 10)
+        table["bool"] = rand(Bool, 10)
+        table["int"] = rand(Int32, 10)
+        table["float"] = rand(Float32, 10)
+        table["double"] = rand(Float64, 10)
+        table["complex"] = rand(Complex64, 10)
+        table["string"] = [randstring(5) for row = 1:10]
+        table["array"] = rand(Complex64, 4, 3, 10)
+        table["bools"] = rand(Bool, 2, 10)
+
+        if Tables.arrow_available()
+            Tables.export_arrow(table, arrow_path, chunk_rows=3)
+            imported = Tables.import_arrow(arrow_path, tempname()*".ms")
+            @test Tables.num_rows(imported) == 10
+            for column in ("bool", "int", "float", "double", "complex", "string", "array", "bools")
+                @test imported[column] == table[column]
+            end
+            Tables.delete(imported)
+            rm(arrow_path)
+
+            Tables.export_arrow(table, arrow_path, columns=["double", "array"], rows=3:7)
+            imported = Tables.import_arrow(arrow_path, tempname()*".ms")
+            @test Tables.num_columns(imported) == 2
+            @test imported["double"] == table["double"][3:7]
+            @test imported["array"] == table["array"][:, :, 3:7]
+            @test_throws CasaCoreTablesError Tables.import_arrow(arrow_path, imported.path)
+            Tables.delete(imported)
+
+            # a malformed shape in the field metadata is reported as an error
+            bytes = read(arrow_path)
+            range = search(String(copy(bytes)), "4,3")
+            bytes[last(range)] = UInt8('x')
+            write(arrow_path, bytes)
+            bad_path = tempname()*".ms"
+            @test_throws CasaCoreTablesError Tables.import_arrow(arrow_path, bad_path)
+            @test !isdir(bad_path)
+            rm(arrow_path)
+
+            table["ragged"] = Tables.RaggedColumn([randn(n) for n = 1:10])
+            @test_throws(CasaCoreTablesError,
+                         Tables.export_arrow(table, arrow_path, columns=["ragged"]))
+            @test_throws(CasaCoreTablesError,
+                         Tables.export_arrow(table, arrow_path, columns=["nope"]))
+            @test_throws CasaCoreTablesError Tables.export_arrow(table, arrow_path, rows=5:11)
+        else
+            @test_throws CasaCoreTablesError Tables.export_arrow(table, arrow_path)
+            @test_throws CasaCoreTablesError Tables.import_arrow(arrow_path, tempname()*".ms")
+        end
+
+        Tables.delete(table)
+    end
+
     @testset "basic cells" begin
         path = tempname()*".ms"
         table = Tables.create(path)
@@ -301,6 +763,47 @@
         Tables.delete(table)
     end
 
+    @testset "bulk keywords" begin
+        path = tempname()*".ms"
+        table = Tables.create(path)
+        Tables.add_rows!(table, 10)
+        Tables.add_column!(table, "column", Float64, (10,))
+        subtable = Tables.create(path*"/SUBTABLE")
+
+        keywords = Dict{String, Any}("bool" => true, "int" => Int32(42),
+                                     "float" => rand(Float32), "double" => rand(Float64),
+                                     "complex" => rand(Complex64), "string" => "I am a banana!",
+                                     "array" => rand(Float64, 3, 4),
+                                     "strings" => ["I", "am", "a", "banana!"],
+                                     "record" => Dict{String, Any}("nested" => Int32(1),
+                                                                   "array" => rand(Complex64, 2)))
+        Tables.write_keywords!(table, keywords)
+        @test Tables.read_keywords(table) == keywords
+        @test table[kw"double"] == keywords["double"]
+        @test table[kw"strings"] == keywords["strings"]
+
+        # existing keywords are preserved
+        table[kw"other"] = 1.0
+        Tables.write_keywords!(table, Dict("int" => Int32(43)))
+        @test table[kw"int"] == 43
+        @test table[kw"other"] == 1.0
+
+        # subtables are returned by name
+        table[kw"SUBTABLE"] = subtable
+        @test Tables.read_keywords(table)["SUBTABLE"] == "Table: "*subtable.path
+        Tables.close(subtable)
+
+        Tables.write_keywords!(table, "column", keywords)
+        @test Tables.read_keywords(table, "column") == keywords
+        @test Tables.read_keywords(table, "column")["record"]["nested"] == 1
+        @test_throws CasaCoreTablesError Tables.read_keywords(table, "colunm") # typo
+        @test_throws CasaCoreTablesError Tables.write_keywords!(table, Dict("bad" => Float16(0)))
+
+        Tables.close(table)
+        @test_throws CasaCoreTablesError Tables.read_keywords(table)
+        Tables.delete(table)
+    end
+
     @testset "old tests" begin
         path = tempname()*".ms"
         table = Tables.create(path)